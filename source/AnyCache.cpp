@@ -0,0 +1,134 @@
+#include "AnyCache.h"
+
+const char* AnyCache::CACHE_DIRECTORY = "configCache";
+
+String AnyCache::cacheFilename(const String& filename) {
+	const size_t pathHash = HashTrait<String>::hashCode(FileSystem::resolve(filename));
+	return FilePath::concat(CACHE_DIRECTORY, format("%s.%016llx.cache", FilePath::baseExt(filename).c_str(), (unsigned long long)pathHash));
+}
+
+Any AnyCache::load(const String& filename, bool useCache) {
+	if (!useCache) return Any::fromFile(filename);
+
+	const uint64 hash = contentHash(filename);
+	const String cacheFile = cacheFilename(filename);
+	if (hash != 0 && FileSystem::exists(cacheFile)) {
+		try {
+			BinaryInput in(cacheFile, G3D_LITTLE_ENDIAN);
+			if (in.readInt32() == MAGIC && in.readInt32() == VERSION && in.readUInt64() == hash) {
+				return deserialize(in);
+			}
+		}
+		catch (...) {
+			logPrintf("WARNING: Could not read config cache \"%s\", parsing \"%s\" instead!\n", cacheFile.c_str(), filename.c_str());
+		}
+	}
+
+	// Parse the file (the slow path) and cache the result for next time
+	const Any a = Any::fromFile(filename);
+	if (hash != 0) {
+		try {
+			if (!FileSystem::exists(CACHE_DIRECTORY)) FileSystem::createDirectory(CACHE_DIRECTORY);
+			BinaryOutput out(cacheFile, G3D_LITTLE_ENDIAN);
+			out.writeInt32(MAGIC);
+			out.writeInt32(VERSION);
+			out.writeUInt64(hash);
+			serialize(a, out);
+			out.commit();
+		}
+		catch (...) {
+			logPrintf("WARNING: Could not write config cache \"%s\"!\n", cacheFile.c_str());
+		}
+	}
+	return a;
+}
+
+uint64 AnyCache::contentHash(const String& filename) {
+	// FNV-1a over the text of this file and (transitively) any files it includes
+	uint64 hash = 0xcbf29ce484222325ull;
+	Array<String> files = { filename };
+	for (int i = 0; i < files.size(); i++) {
+		if (!FileSystem::exists(files[i])) return 0;		// Can't track changes to this file, don't cache
+		const String text = readWholeFile(files[i]);
+		for (const char c : text) {
+			hash ^= uint8(c);
+			hash *= 0x100000001b3ull;
+		}
+		hash ^= uint64(text.size());
+
+		// Find any includes (resolved relative to this file, then the working directory)
+		size_t pos = text.find("#include");
+		while (pos != String::npos) {
+			const size_t start = text.find('"', pos);
+			const size_t end = start == String::npos ? String::npos : text.find('"', start + 1);
+			if (end == String::npos) break;
+			String include = text.substr(start + 1, end - start - 1);
+			const String relative = FilePath::concat(FilePath::parent(files[i]), include);
+			if (FileSystem::exists(relative)) include = relative;
+			if (!files.contains(include)) files.append(include);
+			pos = text.find("#include", end);
+		}
+	}
+	return hash == 0 ? 1 : hash;
+}
+
+void AnyCache::serialize(const Any& a, BinaryOutput& out) {
+	out.writeUInt8(uint8(a.type()));
+	out.writeString32(a.name());
+	switch (a.type()) {
+	case Any::BOOLEAN:
+		out.writeBool8(a.boolean());
+		break;
+	case Any::NUMBER:
+		out.writeFloat64(a.number());
+		break;
+	case Any::STRING:
+		out.writeString32(a.string());
+		break;
+	case Any::ARRAY:
+		out.writeInt32(a.size());
+		for (int i = 0; i < a.size(); i++) { serialize(a[i], out); }
+		break;
+	case Any::TABLE:
+		out.writeInt32(a.size());
+		for (Any::AnyTable::Iterator it = a.table().begin(); it.isValid(); ++it) {
+			out.writeString32(it->key);
+			serialize(it->value, out);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+Any AnyCache::deserialize(BinaryInput& in) {
+	const Any::Type type = Any::Type(in.readUInt8());
+	const String name = in.readString32();
+	switch (type) {
+	case Any::BOOLEAN:
+		return Any(in.readBool8());
+	case Any::NUMBER:
+		return Any(in.readFloat64());
+	case Any::STRING:
+		return Any(in.readString32());
+	case Any::ARRAY: {
+		Any a(Any::ARRAY, name);
+		const int size = in.readInt32();
+		for (int i = 0; i < size; i++) { a.append(deserialize(in)); }
+		return a;
+	}
+	case Any::TABLE: {
+		Any a(Any::TABLE, name);
+		const int size = in.readInt32();
+		for (int i = 0; i < size; i++) {
+			const String key = in.readString32();
+			a[key] = deserialize(in);
+		}
+		return a;
+	}
+	case Any::NIL:
+		return Any();
+	default:
+		return Any(type, name);
+	}
+}
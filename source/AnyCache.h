@@ -0,0 +1,26 @@
+#pragma once
+
+#include <G3D/G3D.h>
+
+/** Binary cache for parsed Any files (used to speed up loading large experiment configs).
+	The cache (written to CACHE_DIRECTORY) stores the fully parsed (#include resolved) Any tree
+	and is keyed by a hash of the text of the file and every file it includes, so editing any of them invalidates it.
+	The cached tree doesn't carry source locations, so callers should re-parse the text to report errors (see ExperimentConfig::load()). */
+class AnyCache {
+public:
+	static const int MAGIC = 0x43414E59;		///< Identifies cache files ("YNAC")
+	static const int VERSION = 1;				///< Increment when the binary format changes
+	static const char* CACHE_DIRECTORY;			///< Directory (relative to the working directory) cache files are written to
+
+	/** Load an Any file, reading its binary cache when it is up to date (and writing it when not) if useCache is set */
+	static Any load(const String& filename, bool useCache = true);
+
+	/** Get the cache file used for an Any file (named by the file and a hash of its full path) */
+	static String cacheFilename(const String& filename);
+
+	/** Hash the text of a file and any files it #includes (returns 0 if the file or one of its includes can't be found) */
+	static uint64 contentHash(const String& filename);
+
+	static void serialize(const Any& a, BinaryOutput& out);
+	static Any deserialize(BinaryInput& in);
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <deque>
+#include <functional>
+
+/** Bookkeeping for a ring of delayed frames, independent of the type used to store each frame (e.g. a framebuffer).
+	Slots are allocated lazily (as frames are written) and the oldest slots are released as soon as the capacity drops.
+	Slots are kept in order from oldest (index 0) to newest (the frame currently being written). */
+template <class T>
+class DelayRing {
+public:
+	using Allocator = std::function<T(int index)>;
+
+protected:
+	struct Slot {
+		T		value;				///< Resource held by this slot
+		double	time;				///< Time at which this slot was last written
+	};
+
+	std::deque<Slot>	m_slots;					///< Written slots (oldest to newest)
+	int					m_capacity = 0;				///< Maximum number of slots to hold (current frame + delayed frames)
+	Allocator			m_allocate;					///< Method used to create the resource for a new slot
+	int					m_allocations = 0;			///< Total count of slots allocated (for diagnostics)
+
+public:
+	DelayRing(Allocator allocate = nullptr) : m_allocate(allocate) {}
+
+	void setAllocator(Allocator allocate) { m_allocate = allocate; }
+
+	/** Set the number of slots to hold, releasing the oldest slots if the capacity shrinks (new slots are only allocated as frames are written) */
+	void setCapacity(int capacity) {
+		m_capacity = capacity > 0 ? capacity : 0;
+		while ((int)m_slots.size() > m_capacity) { m_slots.pop_front(); }
+	}
+
+	/** Release all slots (capacity is unchanged, slots will be allocated again as frames are written) */
+	void clear() { m_slots.clear(); }
+
+	int capacity() const { return m_capacity; }
+	int size() const { return (int)m_slots.size(); }
+	bool empty() const { return m_slots.empty(); }
+	int allocations() const { return m_allocations; }
+
+	/** Get the slot to write the current frame into, reusing the oldest slot once the ring is full */
+	T& beginFrame(double time) {
+		if ((int)m_slots.size() < m_capacity) {
+			m_slots.push_back({ m_allocate((int)m_slots.size()), time });
+			m_allocations++;
+		}
+		else {
+			Slot slot = std::move(m_slots.front());
+			m_slots.pop_front();
+			slot.time = time;
+			m_slots.push_back(std::move(slot));
+		}
+		return m_slots.back().value;
+	}
+
+	T& at(int idx) { return m_slots[idx].value; }
+	const T& at(int idx) const { return m_slots[idx].value; }
+	double time(int idx) const { return m_slots[idx].time; }
+
+	T& oldest() { return m_slots.front().value; }
+	T& newest() { return m_slots.back().value; }
+
+	/** Get the index of the newest slot written at or before the provided time (or the oldest slot if none were) */
+	int newestBefore(double time) const {
+		for (int i = (int)m_slots.size() - 1; i > 0; i--) {
+			if (m_slots[i].time <= time) return i;
+		}
+		return 0;
+	}
+};
@@ -0,0 +1,321 @@
+#include "EventLogger.h"
+#include "Logger.h"
+#include <chrono>
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#endif
+
+#ifdef _WIN32
+bool SerialPort::open(const String& name, int baud, int timeoutMs) {
+	close();
+	// The "\\.\" prefix is required for ports above COM9
+	const String path = beginsWith(name, "\\\\") ? name : "\\\\.\\" + name;
+	m_handle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_EXISTING, 0, NULL);
+	if (m_handle == INVALID_HANDLE_VALUE) return false;
+
+	DCB dcb = {};
+	dcb.DCBlength = sizeof(dcb);
+	GetCommState(m_handle, &dcb);
+	dcb.BaudRate = baud;
+	dcb.ByteSize = 8;
+	dcb.Parity = NOPARITY;
+	dcb.StopBits = ONESTOPBIT;
+	// Return as soon as any bytes are available (or after the timeout)
+	COMMTIMEOUTS timeouts = {};
+	timeouts.ReadIntervalTimeout = MAXDWORD;
+	timeouts.ReadTotalTimeoutMultiplier = MAXDWORD;
+	timeouts.ReadTotalTimeoutConstant = timeoutMs;
+	if (!SetCommState(m_handle, &dcb) || !SetCommTimeouts(m_handle, &timeouts)) {
+		close();
+		return false;
+	}
+	PurgeComm(m_handle, PURGE_RXCLEAR);
+	return true;
+}
+
+void SerialPort::close() {
+	if (m_handle != INVALID_HANDLE_VALUE) CloseHandle(m_handle);
+	m_handle = INVALID_HANDLE_VALUE;
+}
+
+bool SerialPort::isOpen() const { return m_handle != INVALID_HANDLE_VALUE; }
+
+int SerialPort::read(char* buffer, int size) {
+	DWORD count = 0;
+	if (!ReadFile(m_handle, buffer, DWORD(size), &count, NULL)) return -1;
+	return int(count);
+}
+
+bool SerialPort::write(const String& data) {
+	DWORD count = 0;
+	return WriteFile(m_handle, data.c_str(), DWORD(data.size()), &count, NULL) && count == data.size();
+}
+
+void SerialPort::pulseDTR() {
+	EscapeCommFunction(m_handle, SETDTR);
+	EscapeCommFunction(m_handle, CLRDTR);
+}
+#else
+bool SerialPort::open(const String& name, int baud, int timeoutMs) {
+	close();
+	m_fd = ::open(name.c_str(), O_RDWR | O_NOCTTY);
+	if (m_fd < 0) return false;
+
+	termios tty;
+	if (tcgetattr(m_fd, &tty) != 0) {
+		close();
+		return false;
+	}
+	cfmakeraw(&tty);
+	const speed_t speed = baud == 9600 ? B9600 : baud == 57600 ? B57600 : B115200;
+	cfsetispeed(&tty, speed);
+	cfsetospeed(&tty, speed);
+	// Return as soon as any bytes are available (or after the timeout, in tenths of a second)
+	tty.c_cc[VMIN] = 0;
+	tty.c_cc[VTIME] = cc_t(clamp(timeoutMs / 100, 1, 255));
+	if (tcsetattr(m_fd, TCSANOW, &tty) != 0) {
+		close();
+		return false;
+	}
+	tcflush(m_fd, TCIFLUSH);
+	return true;
+}
+
+void SerialPort::close() {
+	if (m_fd >= 0) ::close(m_fd);
+	m_fd = -1;
+}
+
+bool SerialPort::isOpen() const { return m_fd >= 0; }
+
+int SerialPort::read(char* buffer, int size) {
+	return int(::read(m_fd, buffer, size_t(size)));
+}
+
+bool SerialPort::write(const String& data) {
+	return ::write(m_fd, data.c_str(), data.size()) == ssize_t(data.size());
+}
+
+void SerialPort::pulseDTR() {
+	int flag = TIOCM_DTR;
+	ioctl(m_fd, TIOCMBIS, &flag);
+	ioctl(m_fd, TIOCMBIC, &flag);
+}
+#endif
+
+EventLogger::EventLogger(const String& com, bool hasSync, const String& syncComPort) : m_com(com), m_hasSync(hasSync), m_syncComPort(syncComPort) {}
+
+EventLogger::EventLogger(const shared_ptr<ByteStream>& source) : m_com("emulator"), m_source(source) {}
+
+uint64 EventLogger::hostTime() {
+#ifdef _WIN32
+	const FILETIME ft = FPSciLogger::getFileTime();
+	return (uint64(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+#else
+	// Convert to FILETIME ticks (100ns since 1601)
+	const auto now = std::chrono::system_clock::now().time_since_epoch();
+	return uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count() / 100) + 116444736000000000ull;
+#endif
+}
+
+bool EventLogger::parseLine(const char* line, int length, uint64& timeUs, EventType& type) {
+	// Parse "<time>:<event>" in place (this runs for every line, including ADC samples when they are reported)
+	while (length > 0 && isspace(line[length - 1])) { length--; }
+	int i = 0;
+	while (i < length && isspace(line[i])) { i++; }
+
+	const int digitsStart = i;
+	uint64 time = 0;
+	while (i < length && line[i] >= '0' && line[i] <= '9') { time = 10 * time + uint64(line[i++] - '0'); }
+	if (i == digitsStart || i >= length || line[i] != ':') return false;
+	i++;
+	while (i < length && isspace(line[i])) { i++; }
+
+	// Events are 2 characters (everything else is an ADC sample or noise)
+	if (length - i != 2) return false;
+	const Array<String>& names = eventTypeNames();
+	for (int e = 0; e < names.size(); e++) {
+		if (line[i] == names[e][0] && line[i + 1] == names[e][1]) {
+			timeUs = time;
+			type = EventType(e);
+			return true;
+		}
+	}
+	return false;
+}
+
+void EventLogger::resetParser() {
+	m_wrapOffsetUs = 0;
+	m_lastTimeUs = 0;
+	for (int i = 0; i < 4; i++) {
+		m_lastTypeTimeUs[i] = 0;
+		m_seenType[i] = false;
+	}
+	m_clockOffset = 0;
+	m_synced = false;
+	m_hardSynced = false;
+	m_syncHostTime = 0;
+	m_clickPending = false;
+	m_clickTimeUs = 0;
+}
+
+void EventLogger::processLine(const char* line, int length, uint64 hostTicks) {
+	uint64 timeUs;
+	EventType type;
+	if (!parseLine(line, length, timeUs, type)) return;
+
+	// Handle the (32-bit) device timer wrapping around (a jump back of more than 100s)
+	timeUs += m_wrapOffsetUs;
+	if (timeUs + 100000000ull < m_lastTimeUs) {
+		m_wrapOffsetUs += TIMER_WRAP_US;
+		timeUs += TIMER_WRAP_US;
+	}
+	m_lastTimeUs = max(m_lastTimeUs, timeUs);
+
+	// Debounce events of the same type
+	const int t = int(type);
+	if (m_seenType[t] && timeUs >= m_lastTypeTimeUs[t] && timeUs - m_lastTypeTimeUs[t] < MIN_EVENT_SPACING_US) return;
+	m_seenType[t] = true;
+	m_lastTypeTimeUs[t] = timeUs;
+
+	// Map device time onto the host clock. With a DTR sync the first SW event marks the sync pulse, otherwise
+	// use the smallest (host - device) offset seen so far, as the USB transfer only ever adds delay
+	const int64 deviceTicks = int64(timeUs * 10);
+	if (type == EventType::SW && m_syncHostTime != 0 && !m_hardSynced) {
+		m_clockOffset = int64(m_syncHostTime) - deviceTicks;
+		m_synced = m_hardSynced = true;
+	}
+	else if (!m_hardSynced) {
+		const int64 offset = int64(hostTicks) - deviceTicks;
+		if (!m_synced || offset < m_clockOffset) m_clockOffset = offset;
+		m_synced = true;
+	}
+
+	if (notNull(m_logger)) m_logger->logHardwareEvent(HardwareEvent{ uint64(deviceTicks + m_clockOffset), type });
+	m_eventCount++;
+
+	// Measure click-to-photon latency (from the last click to the next photodetector event)
+	if (type == EventType::M1) {
+		m_clickPending = true;
+		m_clickTimeUs = timeUs;
+	}
+	else if (type == EventType::PD && m_clickPending) {
+		m_clickPending = false;
+		if (timeUs - m_clickTimeUs < MAX_CLICK_TO_PHOTON_US) {
+			const float latencyMs = float(timeUs - m_clickTimeUs) / 1000.0f;
+			if (notNull(m_logger)) m_logger->logClickLatency(ClickLatency{ uint64(int64(m_clickTimeUs * 10) + m_clockOffset), latencyMs, m_mode });
+			m_lastLatencyMs = latencyMs;
+			m_stats.add(latencyMs);
+			m_latencyCount++;
+		}
+	}
+}
+
+void EventLogger::readThreadEntry() {
+	std::string buffer;
+	char chunk[256];
+	while (m_running) {
+		const int count = m_stream->read(chunk, sizeof(chunk));
+		if (count < 0) {
+			logPrintf("ERROR: Lost connection to the event logger on \"%s\"!\n", m_com.c_str());
+			break;
+		}
+		if (count == 0) continue;
+
+		// All lines in this read arrived at (about) the same time
+		const uint64 now = hostTime();
+		buffer.append(chunk, size_t(count));
+		size_t start = 0;
+		size_t end;
+		while ((end = buffer.find('\n', start)) != std::string::npos) {
+			processLine(buffer.c_str() + start, int(end - start), now);
+			start = end + 1;
+		}
+		buffer.erase(0, start);		// Keep any partial line for the next read
+	}
+}
+
+bool EventLogger::start(const shared_ptr<FPSciLogger>& logger, const String& mode) {
+	stop();
+	if (notNull(m_source)) {
+		m_stream = m_source.get();
+	}
+	else if (m_port.open(m_com)) {
+		m_stream = &m_port;
+	}
+	else {
+		logPrintf("ERROR: Could not open the event logger on \"%s\"!\n", m_com.c_str());
+		return false;
+	}
+	m_logger = logger;
+	m_mode = mode;
+	resetParser();
+	m_stats.clear();				// Latency statistics are reported per session
+	m_stream->write("aoff\n");		// Don't report ADC samples
+
+	if (m_hasSync) {
+		SerialPort sync;
+		if (sync.open(m_syncComPort)) {
+			m_syncHostTime = hostTime();
+			sync.pulseDTR();
+		}
+		else {
+			logPrintf("WARNING: Could not open the sync port \"%s\", syncing the event logger using its first event instead!\n", m_syncComPort.c_str());
+		}
+	}
+
+	logPrintf("Started event logger on \"%s\" (%s mode)\n", m_com.c_str(), mode.c_str());
+	m_running = true;
+	m_thread = std::thread(&EventLogger::readThreadEntry, this);
+	return true;
+}
+
+void EventLogger::stop() {
+	m_running = false;
+	if (m_thread.joinable()) m_thread.join();
+	m_port.close();
+	m_stream = nullptr;
+	m_logger.reset();
+}
+
+int EventLoggerEmulator::read(char* buffer, int size) {
+	std::unique_lock<std::mutex> lk(m_mutex);
+	m_cv.wait_for(lk, std::chrono::milliseconds(m_timeoutMs), [this] { return !m_pending.empty(); });
+	const int count = min(size, int(m_pending.size()));
+	m_pending.copy(buffer, size_t(count));
+	m_pending.erase(0, size_t(count));
+	return count;
+}
+
+bool EventLoggerEmulator::write(const String& data) {
+	std::lock_guard<std::mutex> lk(m_mutex);
+	m_received += data;
+	return true;
+}
+
+void EventLoggerEmulator::send(uint64 timeUs, EventLogger::EventType type) {
+	// The hardware reports its (32-bit) microsecond timer
+	sendRaw(format("%llu:%s\n", (unsigned long long)(timeUs % EventLogger::TIMER_WRAP_US), EventLogger::eventTypeNames()[int(type)].c_str()));
+}
+
+void EventLoggerEmulator::sendAdc(uint64 timeUs, int value) {
+	sendRaw(format("%llu:%d\n", (unsigned long long)(timeUs % EventLogger::TIMER_WRAP_US), value));
+}
+
+void EventLoggerEmulator::sendRaw(const String& text) {
+	{
+		std::lock_guard<std::mutex> lk(m_mutex);
+		m_pending.append(text.c_str(), text.size());
+	}
+	m_cv.notify_one();
+}
+
+String EventLoggerEmulator::received() {
+	std::lock_guard<std::mutex> lk(m_mutex);
+	return m_received;
+}
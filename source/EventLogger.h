@@ -0,0 +1,165 @@
+#pragma once
+
+#include <G3D/G3D.h>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include "LatencyStats.h"
+
+class FPSciLogger;
+
+/** Stream of bytes to/from the hardware event logger (a SerialPort, or an EventLoggerEmulator for testing) */
+class ByteStream {
+public:
+	virtual ~ByteStream() {}
+	/** Read up to size bytes, returns the count read (0 on timeout) or -1 on error */
+	virtual int read(char* buffer, int size) = 0;
+	virtual bool write(const String& data) = 0;
+};
+
+/** Minimal serial port (a COM port on Windows, a tty elsewhere) used to talk to the hardware event logger */
+class SerialPort : public ByteStream {
+protected:
+#ifdef _WIN32
+	HANDLE			m_handle = INVALID_HANDLE_VALUE;
+#else
+	int				m_fd = -1;
+#endif
+
+public:
+	SerialPort() {};
+	SerialPort(const SerialPort&) = delete;
+	~SerialPort() { close(); }
+
+	/** Open the port (i.e. "COM3" or "/dev/pts/2") at the given baud rate, reads time out after timeoutMs */
+	bool open(const String& name, int baud = 115200, int timeoutMs = 300);
+	void close();
+	bool isOpen() const;
+
+	int read(char* buffer, int size) override;
+	bool write(const String& data) override;
+	/** Toggle the DTR line (used to sync the event logger to the PC clock) */
+	void pulseDTR();
+};
+
+/** Native reader for the hardware click-to-photon event logger (replaces the event_logger.py/event_log_insert.py scripts).
+	The logger reports one "<time in us>:<event>" line per event (M1/M2 mouse buttons, PD photodetector, SW sync), or "<time in us>:<value>" for ADC samples.
+	Lines are read and parsed on their own thread, timestamped against the FPSciLogger clock, and written to the "Events" and "Click_Latencies" tables as they arrive. */
+class EventLogger : public ReferenceCountedObject {
+public:
+	enum class EventType { M1, M2, PD, SW };
+	static const Array<String>& eventTypeNames() {
+		static const Array<String> names = { "M1", "M2", "PD", "SW" };
+		return names;
+	}
+
+	static const uint64 TIMER_WRAP_US = 1ull << 32;				///< The logger's (32-bit) microsecond timer wraps every ~71 minutes
+	static const uint64 MIN_EVENT_SPACING_US = 100000;			///< Minimum spacing between two events of the same type (debounce)
+	static const uint64 MAX_CLICK_TO_PHOTON_US = 300000;		///< Maximum delay expected between a click and its photon
+
+	/** Parse a single line of the serial protocol, returns false for ADC samples and malformed lines */
+	static bool parseLine(const char* line, int length, uint64& timeUs, EventType& type);
+
+	/** Current time on the FPSciLogger clock (in FILETIME 100ns ticks) */
+	static uint64 hostTime();
+
+protected:
+	SerialPort					m_port;									///< Port the event logger is connected to
+	String						m_com;									///< Name of the event logger port
+	shared_ptr<ByteStream>		m_source;								///< Stream read instead of the port (when provided, i.e. for testing)
+	ByteStream*					m_stream = nullptr;						///< Stream being read (m_port or m_source)
+	bool						m_hasSync = false;						///< Sync to the PC using the DTR line of another serial port?
+	String						m_syncComPort;							///< Name of the serial port used for DTR sync
+
+	std::thread					m_thread;								///< Thread reading/parsing the serial port
+	std::atomic<bool>			m_running = { false };					///< Is the read thread running?
+	shared_ptr<FPSciLogger>		m_logger;								///< Results logger events/latencies are written to
+	String						m_mode;									///< Click-to-photon mode (logged with each latency)
+
+	// Parser state (only touched by the read thread once started)
+	uint64						m_wrapOffsetUs = 0;						///< Accumulated offset for timer wrap arounds
+	uint64						m_lastTimeUs = 0;						///< Last (unwrapped) event time
+	uint64						m_lastTypeTimeUs[4] = {};				///< Last (unwrapped) time for each event type (for debounce)
+	bool						m_seenType[4] = {};						///< Has each event type been seen yet?
+	int64						m_clockOffset = 0;						///< Host ticks minus device ticks
+	bool						m_synced = false;						///< Has the clock offset been set?
+	bool						m_hardSynced = false;					///< Was the offset set by a DTR sync (don't refine it)?
+	uint64						m_syncHostTime = 0;						///< Host time of the DTR sync pulse
+	bool						m_clickPending = false;					///< Waiting for the photon from the last click?
+	uint64						m_clickTimeUs = 0;						///< Time of the last click
+
+	std::atomic<int>			m_eventCount = { 0 };					///< Count of events logged
+	std::atomic<int>			m_latencyCount = { 0 };					///< Count of click-to-photon latencies measured
+	std::atomic<float>			m_lastLatencyMs = { 0.0f };				///< Most recent click-to-photon latency
+	ClickToPhotonStats			m_stats;								///< Streaming latency statistics (per trial and condition)
+
+	void readThreadEntry();
+
+public:
+	EventLogger(const String& com, bool hasSync = false, const String& syncComPort = "");
+	/** Read events from the provided stream instead of a serial port */
+	EventLogger(const shared_ptr<ByteStream>& source);
+	virtual ~EventLogger() { stop(); }
+
+	static shared_ptr<EventLogger> create(const String& com, bool hasSync = false, const String& syncComPort = "") {
+		return createShared<EventLogger>(com, hasSync, syncComPort);
+	}
+	static shared_ptr<EventLogger> create(const shared_ptr<ByteStream>& source) {
+		return createShared<EventLogger>(source);
+	}
+
+	/** Start reading events into the given results logger, returns false if the port couldn't be opened */
+	bool start(const shared_ptr<FPSciLogger>& logger, const String& mode);
+	/** Stop reading events (and release the results logger) */
+	void stop();
+	bool running() const { return m_running; }
+	int eventCount() const { return m_eventCount; }
+	int latencyCount() const { return m_latencyCount; }
+	float lastLatencyMs() const { return m_lastLatencyMs; }
+	/** Click-to-photon latency statistics (for the current trial and each frame rate condition) */
+	ClickToPhotonStats& stats() { return m_stats; }
+
+	/** Handle a line received at hostTicks (called from the read thread, or directly for testing) */
+	void processLine(const char* line, int length, uint64 hostTicks);
+	/** Reset the parser (timer wrap, debounce, sync, and click state) */
+	void resetParser();
+};
+
+/** A hardware event (written to the "Events" table), time is in FILETIME ticks on the FPSciLogger clock */
+struct HardwareEvent {
+	uint64					time;
+	EventLogger::EventType	type;
+};
+
+/** A click-to-photon latency (written to the "Click_Latencies" table), time is the click time */
+struct ClickLatency {
+	uint64					time;
+	float					latencyMs;
+	String					mode;
+};
+
+/** Emulates the hardware event logger in memory (for testing without hardware), provide it to EventLogger::create() */
+class EventLoggerEmulator : public ByteStream {
+protected:
+	std::mutex				m_mutex;
+	std::condition_variable	m_cv;
+	std::string				m_pending;				///< Bytes sent but not yet read
+	String					m_received;				///< Bytes written (commands) by the EventLogger
+	int						m_timeoutMs;			///< Read timeout (as for the serial port)
+
+public:
+	EventLoggerEmulator(int timeoutMs = 100) : m_timeoutMs(timeoutMs) {}
+
+	int read(char* buffer, int size) override;
+	bool write(const String& data) override;
+
+	/** Send an event (as the hardware would) at the given device time */
+	void send(uint64 timeUs, EventLogger::EventType type);
+	/** Send an ADC sample (ignored by the logger) */
+	void sendAdc(uint64 timeUs, int value);
+	/** Send raw text */
+	void sendRaw(const String& text);
+	/** Commands written by the EventLogger so far */
+	String received();
+};
@@ -1,4 +1,8 @@
 #include "ExperimentConfig.h"
+#include "AnyCache.h"
+#include <thread>
+#include <vector>
+#include <atomic>
 
 ExperimentConfig::ExperimentConfig(const Any& any) : FpsConfig(any) {
 	FPSciAnyTableReader reader(any);
@@ -10,7 +14,12 @@ ExperimentConfig::ExperimentConfig(const Any& any) : FpsConfig(any) {
 		reader.getIfPresent("description", description);
 		reader.getIfPresent("closeOnComplete", closeOnComplete);
 		reader.get("targets", targets, "Issue in the (required) \"targets\" array for the experiment!");	// Targets must be specified for the experiment
-		reader.get("sessions", sessions, "Issue in the (required) \"sessions\" array for the experiment config!");
+		{
+			Any sessionsAny;
+			reader.get("sessions", sessionsAny, "Issue in the (required) \"sessions\" array for the experiment config!");
+			sessionsAny.verifyType(Any::ARRAY);
+			sessions = parseSessions(sessionsAny.array());
+		}
 		break;
 	default:
 		debugPrintf("Settings version '%d' not recognized in ExperimentConfig.\n", settingsVersion);
@@ -27,7 +36,7 @@ void ExperimentConfig::init() {
 		addedTargets = true;
 		TargetConfig tStatic;
 		tStatic.id = "static";
-		tStatic.destSpace = "player";
+		tStatic.destSpace = TargetConfig::DestSpace::Player;
 		tStatic.speed = Array<float>({ 0.f, 0.f });
 		tStatic.size = Array<float>({ 0.05f, 0.05f });
 
@@ -35,7 +44,7 @@ void ExperimentConfig::init() {
 
 		TargetConfig tMove;
 		tMove.id = "moving";
-		tMove.destSpace = "player";
+		tMove.destSpace = TargetConfig::DestSpace::Player;
 		tMove.size = Array<float>({ 0.05f, 0.05f });
 		tMove.speed = Array<float>({ 7.f, 10.f });
 		tMove.motionChangePeriod = Array<float>({ 0.8f, 1.5f });
@@ -45,7 +54,7 @@ void ExperimentConfig::init() {
 
 		TargetConfig tJump;
 		tJump.id = "jumping";
-		tJump.destSpace = "player";
+		tJump.destSpace = TargetConfig::DestSpace::Player;
 		tJump.size = Array<float>({ 0.05f, 0.05f });
 		tJump.speed = Array<float>({ 10.f, 10.f });
 		tJump.motionChangePeriod = Array<float>({ 0.8f, 1.5f });
@@ -59,7 +68,7 @@ void ExperimentConfig::init() {
 	else {
 		// Targets are present (make sure no 2 have the same ID)
 		Array<String> targetIds;
-		for (TargetConfig target : targets) {
+		for (const TargetConfig& target : targets) {
 			if (!targetIds.contains(target.id)) { targetIds.append(target.id); }
 			else {
 				// This is a repeat entry, throw an exception
@@ -88,7 +97,34 @@ void ExperimentConfig::init() {
 	}
 }
 
-ExperimentConfig ExperimentConfig::load(const String& filename, bool saveJSON) {
+Array<SessionConfig> ExperimentConfig::parseSessions(const Array<Any>& sessionsAny) {
+	// Sessions only depend on the (already setup) experiment-level defaults, so parse them on a pool of threads
+	Array<SessionConfig> result;
+	result.resize(sessionsAny.size());
+	Array<std::exception_ptr> errors;
+	errors.resize(sessionsAny.size());
+	std::atomic<int> next(0);
+	auto parse = [&]() {
+		for (int i = next++; i < sessionsAny.size(); i = next++) {
+			try { result[i] = SessionConfig(sessionsAny[i]); }
+			catch (...) { errors[i] = std::current_exception(); }
+		}
+	};
+
+	const int threadCount = min(sessionsAny.size(), int(std::thread::hardware_concurrency())) - 1;
+	std::vector<std::thread> threads;
+	for (int i = 0; i < threadCount; i++) { threads.emplace_back(parse); }
+	parse();		// This thread parses sessions too
+	for (std::thread& t : threads) { t.join(); }
+
+	// Report the first error (in session order) the way serial parsing would have
+	for (const std::exception_ptr& error : errors) {
+		if (error) std::rethrow_exception(error);
+	}
+	return result;
+}
+
+ExperimentConfig ExperimentConfig::load(const String& filename, bool saveJSON, bool useCache) {
 	ExperimentConfig ex;
 	if (!FileSystem::exists(System::findDataFile(filename, false))) {
 		// if file not found, save the default
@@ -97,7 +133,15 @@ ExperimentConfig ExperimentConfig::load(const String& filename, bool saveJSON) {
 		ex.toAny().save(filename, saveJSON);				// Save the defaults
 	}
 	else {
-		ex = Any::fromFile(System::findDataFile(filename));	// Load from existing Any file
+		const String path = System::findDataFile(filename);
+		try {
+			ex = AnyCache::load(path, useCache);		// Load from existing Any file (or its binary cache)
+		}
+		catch (...) {
+			// The cached tree has no source locations, so re-parse the text to report where the error is
+			if (!useCache) throw;
+			ex = Any::fromFile(path);
+		}
 	}
 	return ex;
 }
@@ -172,13 +216,13 @@ bool ExperimentConfig::validate(bool throwException) const {
 	bool valid = true;
 	// Build list of valid target ids
 	Array<String> validTargetIds;
-	for (TargetConfig target : targets) { validTargetIds.append(target.id); }
+	for (const TargetConfig& target : targets) { validTargetIds.append(target.id); }
 
 	// Validate session targets against provided experiment target list
-	for (SessionConfig session : sessions) {
+	for (const SessionConfig& session : sessions) {
 		Array<String> sessionTargetIds;
 		// Build a list of target ids used in this session
-		for (TrialConfig trial : session.trials) {
+		for (const TrialConfig& trial : session.trials) {
 			for (String id : trial.targetIds) { if (!sessionTargetIds.contains(id)) sessionTargetIds.append(id); }
 		}
 		// Check each ID against the experiment targets array
@@ -16,7 +16,8 @@ public:
 	ExperimentConfig(const Any& any);
 
 	void init();
-	static ExperimentConfig load(const String& filename, bool saveJSON = false); // Get the experiment config from file
+	static ExperimentConfig load(const String& filename, bool saveJSON = false, bool useCache = true); // Get the experiment config from file (or its binary cache)
+	static Array<SessionConfig> parseSessions(const Array<Any>& sessionsAny);	// Parse session configs (in parallel, as they are independent)
 	Any toAny(const bool forceAll = false) const;
 
 	void getSessionIds(Array<String>& ids) const;								// Get an array of session IDs
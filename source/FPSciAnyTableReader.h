@@ -10,7 +10,39 @@ public:
 	// The methods below allow serializing G3D types like Point2, Vector2, Point3, Vector3, Color3, ... from arrays
 	// This allows JSON-serialized Any to be read back into these types successfully
 
+	/** Read a plain (unnamed) array of count numbers into v, returning false (instead of throwing) if the Any is anything else */
+	static bool readNumbers(const Any& a, float* v, int count) {
+		if (a.type() != Any::ARRAY || !a.name().empty() || a.size() != count) return false;
+		for (int i = 0; i < count; i++) {
+			if (a[i].type() != Any::NUMBER) return false;
+		}
+		for (int i = 0; i < count; i++) { v[i] = float(a[i].number()); }
+		return true;
+	}
+
+	/** Fast path for (JSON) arrays of numbers, avoids the exception thrown by AnyTableReader::get() below for these fields */
+	bool getNumbers(const String& s, float* v, int count) {
+		return any().containsKey(s) && readNumbers(any()[s], v, count);
+	}
+
+	/** Fast path for arrays of (JSON) number arrays (i.e. Array<Vector3>), returns false without modifying arr if any element isn't a plain array */
+	template<class T, int N>
+	bool getNumberArrays(const String& s, Array<T>& arr) {
+		static_assert(sizeof(T) == N * sizeof(float), "Type must be N packed floats!");
+		if (!any().containsKey(s)) return false;
+		const Any& a = any()[s];
+		if (a.type() != Any::ARRAY) return false;
+		Array<T> values;
+		values.resize(a.size());
+		for (int i = 0; i < a.size(); i++) {
+			if (!readNumbers(a[i], reinterpret_cast<float*>(&values[i]), N)) return false;
+		}
+		arr = values;
+		return true;
+	}
+
 	void get(const String& s, Vector2& v, const String& errMsg = "")  {
+		if (getNumbers(s, &v.x, 2)) return;
 		try {
 			AnyTableReader::get(s, v, errMsg);
 		}
@@ -31,6 +63,7 @@ public:
 	}
 
 	void get(const String& s, Vector3& v, const String& errMsg = "") {
+		if (getNumbers(s, &v.x, 3)) return;
 		try {
 			AnyTableReader::get(s, v, errMsg);
 		}
@@ -57,6 +90,7 @@ public:
 	}
 
 	void get(const String& s, Vector4& v, const String& errMsg = "") {
+		if (getNumbers(s, &v.x, 4)) return;
 		try {
 			AnyTableReader::get(s, v, errMsg);
 		}
@@ -77,6 +111,11 @@ public:
 	}
 
 	void get(const String& s, Color4& c, const String& errMsg = "") {
+		if (getNumbers(s, &c.r, 4)) return;
+		if (getNumbers(s, &c.r, 3)) {
+			c.a = 1.f;
+			return;
+		}
 		Vector4 v4;
 		try {
 			get(s, v4, errMsg);
@@ -98,6 +137,7 @@ public:
 	// Explicitly support arrays for the types above (this doesn't work well with a tempalted solution)
 
 	void get(const String& s, Array<Vector2>& v, const String& errMsg = "") {
+		if (getNumberArrays<Vector2, 2>(s, v)) return;
 		try {
 			AnyTableReader::get(s, v, errMsg);	// Try normal read approach
 		}
@@ -120,6 +160,7 @@ public:
 	}
 
 	void get(const String& s, Array<Vector3>& v, const String& errMsg = "") {
+		if (getNumberArrays<Vector3, 3>(s, v)) return;
 		try {
 			AnyTableReader::get(s, v, errMsg);	// Try normal read approach
 		}
@@ -142,6 +183,7 @@ public:
 	}
 
 	void get(const String& s, Array<Vector4>& v, const String& errMsg = "") {
+		if (getNumberArrays<Vector4, 4>(s, v)) return;
 		try {
 			AnyTableReader::get(s, v, errMsg);	// Try normal read approach
 		}
@@ -164,6 +206,7 @@ public:
 	}
 
 	void get(const String& s, Array<Color3>& arr, const String& errMsg = "") {
+		if (getNumberArrays<Color3, 3>(s, arr)) return;
 		try {
 			AnyTableReader::get(s, arr, errMsg);	// Try normal read approach
 		}
@@ -186,6 +229,7 @@ public:
 	}
 
 	void get(const String& s, Array<Color4>& arr, const String& errMsg = "") {
+		if (getNumberArrays<Color4, 4>(s, arr)) return;
 		try {
 			AnyTableReader::get(s, arr, errMsg);	// Try normal read approach
 		}
@@ -227,6 +271,25 @@ public:
 		}
 	}
 
+	// Read a (case insensitive) string option into an enum, where names provides the name of each enum value (in order)
+	template<class EnumType>
+	bool getEnumIfPresent(const String& s, EnumType& v, const Array<String>& names) {
+		String str;
+		if (!getIfPresent(s, str)) return false;
+		for (int i = 0; i < names.size(); i++) {
+			if (toLower(str) == toLower(names[i])) {
+				v = EnumType(i);
+				return true;
+			}
+		}
+		String errMsg = "Specified \"" + s + "\" (\"" + str + "\") is invalid, must be one of: [";
+		for (const String& name : names) {
+			errMsg += "\"" + name + "\", ";
+		}
+		errMsg = errMsg.substr(0, errMsg.length() - 2) + "]!";
+		throw errMsg;
+	}
+
 	// Utility Methods
 
 	// Currently unused, allows getting scalar or vector from Any
@@ -8,13 +8,18 @@
 #include <chrono>
 
 // Storage for configuration static vars
-int TrialConfig::defaultCount;
+thread_local int TrialConfig::defaultCount;
 Array<String> UserSessionStatus::defaultSessionOrder;
 bool UserSessionStatus::randomizeDefaults;
 
 StartupConfig FPSciApp::startupConfig;
 
-FPSciApp::FPSciApp(const GApp::Settings& settings) : GApp(settings) {}
+FPSciApp::FPSciApp(const GApp::Settings& settings) : GApp(settings) {
+	// Delay buffers are allocated (at the current resolution) as they are first written
+	m_ldrDelayRing.setAllocator([this](int idx) {
+		return Framebuffer::create(Texture::createEmpty(format("Delay buffer %d", idx), renderDevice->width(), renderDevice->height(), ImageFormat::RGB8()));
+	});
+}
 
 /** Initialize the app */
 void FPSciApp::onInit() {
@@ -22,6 +27,9 @@ void FPSciApp::onInit() {
 	Random::common().reset(uint32(time(0)));
 
 	GApp::onInit();			// Initialize the G3D application (one time)
+	m_passTimer.init();		// Check for GPU timer support (requires the GL context)
+	// Compositor present timing is only meaningful when windowed (otherwise latency is estimated from submit times)
+	if (!window()->settings().fullScreen) m_photonProxy.setPresentClock(PhotonProxy::compositorClock());
 	// TODO: Move validateExperiments() to a developer mode GUI button
 	//startupConfig.validateExperiments();
 	initExperiment();		// Initialize the experiment
@@ -167,7 +175,7 @@ void FPSciApp::setMouseInputMode(MouseInputMode mode) {
 
 void FPSciApp::loadConfigs(const ConfigFiles& configs) {
 	// Load experiment setting from file
-	experimentConfig = ExperimentConfig::load(configs.experimentConfigFilename, startupConfig.jsonAnyOutput);
+	experimentConfig = ExperimentConfig::load(configs.experimentConfigFilename, startupConfig.jsonAnyOutput, startupConfig.cacheExperimentConfig);
 	experimentConfig.printToLog();
 	experimentConfig.validate(true);
 
@@ -211,7 +219,7 @@ void FPSciApp::loadModels() {
 	Table<String, Any> targetsToBuild;
 	Table<String, String> explosionsToBuild;
 	Table<String, float> explosionScales;
-	for (TargetConfig target : experimentConfig.targets) {
+	for (const TargetConfig& target : experimentConfig.targets) {
 		targetsToBuild.set(target.id, target.modelSpec);
 		explosionsToBuild.set(target.id, target.destroyDecal);
 		explosionScales.set(target.id, target.destroyDecalScale);
@@ -233,7 +241,12 @@ void FPSciApp::loadModels() {
 	explosionsToBuild.set("reference", "explosion_01.png");
 	explosionScales.set("reference", 1.0);
 
-	// Scale the models into the m_targetModel table
+	// Store the model specs here, scaled models are built per-session (or on first use)
+	m_targetModelKeys.clear();
+	m_explosionModelKeys.clear();
+	m_modelSpecs.clear();
+	m_scaledModels.clear();
+	Table<String, float> defaultScales;			// Default scale for each unique model spec
 	for (String id : targetsToBuild.getKeys()) {
 		// Get the any specs
 		Any tSpec = targetsToBuild.get(id);
@@ -251,35 +264,43 @@ void FPSciApp::loadModels() {
 				};\
 			}", explosionsToBuild.get(id).c_str()));
 
-		// Get the bounding box to scale to size rather than arbitrary factor
-		shared_ptr<ArticulatedModel> size_model = ArticulatedModel::create(ArticulatedModel::Specification(tSpec));
-		AABox bbox;
-		size_model->getBoundingBox(bbox);
-		Vector3 extent = bbox.extent();
-		logPrintf("%20s bounding box: [%2.2f, %2.2f, %2.2f]\n", id.c_str(), extent[0], extent[1], extent[2]);
-		const float default_scale = 1.0f / extent[0];					// Setup scale so that default model is 1m across
-
-		// Create the target/explosion models for this target
-		Array<shared_ptr<ArticulatedModel>> tModels, expModels;
-		for (int i = 0; i <= TARGET_MODEL_SCALE_COUNT; ++i) {
-			const float scale = pow(1.0f + TARGET_MODEL_ARRAY_SCALING, float(i) - TARGET_MODEL_ARRAY_OFFSET);
-			tSpec.set("scale", scale * default_scale);
-			explosionSpec.set("scale", (20.0 * scale * explosionScales.get(id)));
-			tModels.push(ArticulatedModel::create(tSpec));
-			expModels.push(ArticulatedModel::create(explosionSpec));
+		// Get the bounding box to scale to size rather than arbitrary factor (once per unique model spec)
+		const String specStr = tSpec.unparse();
+		if (!defaultScales.containsKey(specStr)) {
+			shared_ptr<ArticulatedModel> baseModel = ArticulatedModel::create(ArticulatedModel::Specification(tSpec));
+			AABox bbox;
+			baseModel->getBoundingBox(bbox);
+			Vector3 extent = bbox.extent();
+			logPrintf("%20s bounding box: [%2.2f, %2.2f, %2.2f]\n", id.c_str(), extent[0], extent[1], extent[2]);
+			defaultScales.set(specStr, 1.0f / extent[0]);				// Setup scale so that default model is 1m across
 		}
-		targetModels.set(id, tModels);
-		m_explosionModels.set(id, expModels);
+
+		// Store the specs at their base (scale index independent) scales
+		tSpec.set("scale", defaultScales[specStr]);
+		explosionSpec.set("scale", 20.0 * explosionScales.get(id));
+		const String tKey = tSpec.unparse();
+		const String expKey = explosionSpec.unparse();
+		m_modelSpecs.set(tKey, tSpec);
+		m_modelSpecs.set(expKey, explosionSpec);
+		m_targetModelKeys.set(id, tKey);
+		m_explosionModelKeys.set(id, expKey);
 
 		// Create a series of colored materials to choose from for target health
-		shared_ptr<TargetConfig> tconfig = experimentConfig.getTargetConfigById(id);
-		materials.remove(id);
-		materials.set(id, makeMaterials(tconfig));
+		updateMaterials(id, experimentConfig.getTargetConfigById(id));
 	}
 }
 
-Array<shared_ptr<UniversalMaterial>> FPSciApp::makeMaterials(shared_ptr<TargetConfig> tconfig) {
-	Array<shared_ptr<UniversalMaterial>> targetMaterials;
+void FPSciApp::updateMaterials(const String& id, shared_ptr<TargetConfig> tconfig) {
+	// Resolve the colors for each health "level" first (these can fall back to the current trial config)
+	Array<Color4> colors, emissives;
+	Color4 gloss;
+	if (notNull(tconfig) && tconfig->hasGloss) {
+		gloss = tconfig->gloss;
+	}
+	else {
+		gloss = trialConfig->targetView.gloss;
+	}
+	String key = gloss.toString();
 	for (int i = 0; i < matTableSize; i++) {
 		float complete = (float)i / (matTableSize-1);
 		
@@ -290,14 +311,6 @@ Array<shared_ptr<UniversalMaterial>> FPSciApp::makeMaterials(shared_ptr<TargetCo
 		else {
 			color = lerpColor(trialConfig->targetView.healthColors, complete);
 		}
-		
-		Color4 gloss;
-		if (notNull(tconfig) && tconfig->hasGloss) {
-			gloss = tconfig->gloss;
-		}
-		else {
-			gloss = trialConfig->targetView.gloss;
-		}
 
 		Color4 emissive;
 		if (notNull(tconfig) && tconfig->emissive.length() > 0) {
@@ -310,13 +323,33 @@ Array<shared_ptr<UniversalMaterial>> FPSciApp::makeMaterials(shared_ptr<TargetCo
 			emissive = color * 0.7f;	// Historical behavior fallback for unspecified case
 		}
 
-		UniversalMaterial::Specification materialSpecification;
-		materialSpecification.setLambertian(Texture::Specification(color));
-		materialSpecification.setEmissive(Texture::Specification(emissive));
-		materialSpecification.setGlossy(Texture::Specification(gloss));					// Used to be Color4(0.4f, 0.2f, 0.1f, 0.8f)
-		targetMaterials.append(UniversalMaterial::create(materialSpecification));
+		colors.append(color);
+		emissives.append(emissive);
+		key += color.toString() + emissive.toString();
+	}
+
+	// Only build materials (and their poses) once per distinct color spec
+	if (!m_materialCache.containsKey(key)) {
+		Array<shared_ptr<UniversalMaterial>> targetMaterials;
+		Array<shared_ptr<ArticulatedModel::Pose>> targetPoses;
+		for (int i = 0; i < matTableSize; i++) {
+			UniversalMaterial::Specification materialSpecification;
+			materialSpecification.setLambertian(Texture::Specification(colors[i]));
+			materialSpecification.setEmissive(Texture::Specification(emissives[i]));
+			materialSpecification.setGlossy(Texture::Specification(gloss));					// Used to be Color4(0.4f, 0.2f, 0.1f, 0.8f)
+			targetMaterials.append(UniversalMaterial::create(materialSpecification));
+
+			// Create a pose using this material that can be shared by all targets
+			const shared_ptr<ArticulatedModel::Pose>& pose = ArticulatedModel::Pose::create();
+			pose->materialTable.set("core/icosahedron_default", targetMaterials.last());
+			targetPoses.append(pose);
+		}
+		m_materialCache.set(key, targetMaterials);
+		m_poseCache.set(key, targetPoses);
 	}
-	return targetMaterials;
+
+	materials.set(id, m_materialCache[key]);
+	m_healthPoses.set(id, m_poseCache[key]);
 }
 
 Color4 FPSciApp::lerpColor(Array<Color4> colors, float a) {
@@ -350,6 +383,37 @@ Color4 FPSciApp::lerpColor(Array<Color4> colors, float a) {
 	}
 }
 
+shared_ptr<ArticulatedModel> FPSciApp::scaledModel(const String& specKey, const int scaleIdx) {
+	// Models are shared between all target types using the same spec
+	Array<shared_ptr<ArticulatedModel>>& models = m_scaledModels.getCreate(specKey);
+	if (models.size() == 0) models.resize(TARGET_MODEL_SCALE_COUNT + 1);
+	if (isNull(models[scaleIdx])) {
+		const Any& baseSpec = m_modelSpecs[specKey];
+		const float scale = pow(1.0f + TARGET_MODEL_ARRAY_SCALING, float(scaleIdx) - TARGET_MODEL_ARRAY_OFFSET);
+		Any spec = baseSpec;
+		spec.set("scale", scale * float(baseSpec["scale"].number()));
+		models[scaleIdx] = ArticulatedModel::create(spec);
+	}
+	return models[scaleIdx];
+}
+
+shared_ptr<ArticulatedModel> FPSciApp::targetModel(const String& id, const int scaleIdx) {
+	return scaledModel(m_targetModelKeys[id], scaleIdx);
+}
+
+shared_ptr<ArticulatedModel> FPSciApp::explosionModel(const String& id, const int scaleIdx) {
+	return scaledModel(m_explosionModelKeys[id], scaleIdx);
+}
+
+void FPSciApp::buildTargetModels(const String& id, const float minSize, const float maxSize) {
+	const int minIdx = clamp(iRound(log(minSize) / log(1.0f + TARGET_MODEL_ARRAY_SCALING) + TARGET_MODEL_ARRAY_OFFSET), 0, TARGET_MODEL_SCALE_COUNT - 1);
+	const int maxIdx = clamp(iRound(log(maxSize) / log(1.0f + TARGET_MODEL_ARRAY_SCALING) + TARGET_MODEL_ARRAY_OFFSET), 0, TARGET_MODEL_SCALE_COUNT - 1);
+	for (int i = minIdx; i <= maxIdx; i++) {
+		targetModel(id, i);
+		explosionModel(id, i);
+	}
+}
+
 void FPSciApp::updateDeveloperControls(const shared_ptr<FpsConfig>& config) {
 	// Update the waypoint manager
 	if (notNull(waypointManager)) { waypointManager->updateControls(); }
@@ -510,8 +574,8 @@ void FPSciApp::presentQuestion(Question question) {
 }
 
 void FPSciApp::markSessComplete(String sessId) {
-	if (notNull(m_pyLogger)) {
-		m_pyLogger->mergeLogToDb();
+	if (notNull(m_eventLogger)) {
+		m_eventLogger->stop();
 	}
 	// Add the session id to completed session array and save the user status table
 	userStatusTable.addCompletedSession(userStatusTable.currentUser, sessId);
@@ -521,9 +585,10 @@ void FPSciApp::markSessComplete(String sessId) {
 	m_userSettingsWindow->updateSessionDropDown();
 }
 
-void FPSciApp::updateFrameParameters(int frameDelay, float frameRate) {
+void FPSciApp::updateFrameParameters(int frameDelay, float frameRate, float frameDelayMs) {
 	// Apply frame lag
 	displayLagFrames = frameDelay;
+	displayLatencyMs = frameDelayMs;
 	lastSetFrameRate = frameRate;
 	// Set a maximum *finite* frame rate
 	float dt = 0;
@@ -646,12 +711,24 @@ void FPSciApp::updateSession(const String& id, const bool forceSceneReload) {
 		playerCamera = activeCamera();
 	}
 
+	// Release the previous session's delay buffers (reallocated as needed when frames are written)
+	m_ldrDelayRing.clear();
+
 	// Update colored materials to choose from for target health
+	for (String id : sessConfig->getUniqueTargetIds()) {
+		updateMaterials(id, experimentConfig.getTargetConfigById(id));
+	}
+
+	// Build the scaled target models this session can spawn (any others are built on first use)
 	for (String id : sessConfig->getUniqueTargetIds()) {
 		shared_ptr<TargetConfig> tconfig = experimentConfig.getTargetConfigById(id);
-		materials.remove(id);
-		materials.set(id, makeMaterials(tconfig));
+		buildTargetModels(id, tconfig->size[0], tconfig->size[1]);
 	}
+	const String refId = hasTargetModel(sessConfig->id + "_reference") ? sessConfig->id + "_reference" : "reference";
+	buildTargetModels(refId, sessConfig->targetView.refTargetSize, sessConfig->targetView.refTargetSize);
+
+	m_pacingErrors.clear();			// Frame pacing statistics are reported per session
+	m_passTimer.clearSamples();		// Render pass timing is reported per trial
 
 	// Handle clearing the targets here (clear any remaining targets before loading a new scene)
 	if (notNull(scene())) sess->clearTargets();
@@ -682,20 +759,28 @@ void FPSciApp::updateSession(const String& id, const bool forceSceneReload) {
 		if (!sessConfig->clickToPhoton.enabled) {
 			logPrintf("WARNING: Using a click-to-photon logger without the click-to-photon region enabled!\n\n");
 		}
-		if (m_pyLogger == nullptr) {
-			m_pyLogger = PythonLogger::create(systemConfig.loggerComPort, systemConfig.hasSync, systemConfig.syncComPort);
+		if (m_eventLogger == nullptr) {
+			m_eventLogger = EventLogger::create(systemConfig.loggerComPort, systemConfig.hasSync, systemConfig.syncComPort);
 		}
 		else {
-			// Handle running logger if we need to (terminate then merge results)
-			m_pyLogger->mergeLogToDb();
+			// Stop logging into the previous session's results
+			m_eventLogger->stop();
 		}
-		// Run a new logger if we need to (include the mode to run in here...)
-		m_pyLogger->run(logPath, sessConfig->clickToPhoton.mode);
 	}
 
 	// Initialize the experiment (this creates the results file)
 	sess->onInit(logPath, experimentConfig.description + "/" + sessConfig->description);
 
+	// Log hardware events straight into this session's results file
+	if (systemConfig.hasLogger) {
+		if (isNull(sess->logger)) {
+			logPrintf("WARNING: The hardware event logger requires session logging to be enabled to record results!\n");
+		}
+		else {
+			m_eventLogger->start(sess->logger, ClickToPhotonConfig::modeNames()[int(sessConfig->clickToPhoton.mode)]);
+		}
+	}
+
 	// Don't create a results file for a user w/ no sessions left
 	if (m_userSettingsWindow->sessionsForSelectedUser() == 0) {
 		logPrintf("No sessions remaining for selected user.\n");
@@ -709,6 +794,27 @@ void FPSciApp::updateSession(const String& id, const bool forceSceneReload) {
 	}
 }
 
+void FPSciApp::prefetchNextScene() {
+	// Find the session that will follow the current one for this user
+	shared_ptr<UserSessionStatus> status = userStatusTable.getUserStatus(userStatusTable.currentUser);
+	if (isNull(status)) return;
+	String nextId;
+	bool foundCurrent = false;
+	for (const String& id : status->sessionOrder) {
+		if (foundCurrent && !status->completedSessions.contains(id)) { nextId = id; break; }
+		if (id == sessConfig->id) foundCurrent = true;
+	}
+	if (nextId.empty()) return;
+
+	// Prefetch the session-level scene (or the default scene if none is specified)
+	const shared_ptr<SessionConfig> nextConfig = experimentConfig.getSessionConfigById(nextId);
+	if (isNull(nextConfig)) return;
+	const String sceneName = nextConfig->scene.name.empty() ? m_defaultSceneName : nextConfig->scene.name;
+	if (sceneName == m_loadedScene.name) return;		// Already loaded, nothing to fetch
+	logPrintf("Prefetching scene \"%s\" for session: %s\n", sceneName.c_str(), nextId.c_str());
+	PhysicsScene::prefetch(sceneName);
+}
+
 void FPSciApp::updateTrial(const shared_ptr<TrialConfig> config, const bool forceSceneReload, const bool respawn) {
 	trialConfig = config;	// Naive way to store trial config pointer for now
 	updateUserMenu = true;
@@ -726,21 +832,19 @@ void FPSciApp::updateConfigParameters(const shared_ptr<FpsConfig> config, const
 	updateDeveloperControls(config);
 
 	// Update the frame rate/delay
-	updateFrameParameters(config->render.frameDelay, config->render.frameRate);
+	updateFrameParameters(config->render.frameDelay, config->render.frameRate, config->render.frameDelayMs);
 
 	// Handle buffer setup here
 	updateShaderBuffers(config);
 
 	// Update shader table
 	m_shaderTable.clear();
-	if (!config->render.shader3D.empty()) {
-		m_shaderTable.set(config->render.shader3D, G3D::Shader::getShaderFromPattern(config->render.shader3D));
-	}
-	if (!config->render.shader2D.empty()) {
-		m_shaderTable.set(config->render.shader2D, G3D::Shader::getShaderFromPattern(config->render.shader2D));
-	}
-	if (!config->render.shaderComposite.empty()) {
-		m_shaderTable.set(config->render.shaderComposite, G3D::Shader::getShaderFromPattern(config->render.shaderComposite));
+	for (const String& stage : { "3D", "2D", "composite" }) {
+		for (const ShaderPassConfig& pass : config->render.stagePasses(stage)) {
+			if (!pass.shader.empty() && !m_shaderTable.containsKey(pass.shader)) {
+				m_shaderTable.set(pass.shader, G3D::Shader::getShaderFromPattern(pass.shader));
+			}
+		}
 	}
 
 	// Update shader parameters
@@ -749,6 +853,7 @@ void FPSciApp::updateConfigParameters(const shared_ptr<FpsConfig> config, const
 	m_last3DTime = m_startTime;
 	m_lastCompositeTime = m_startTime;
 	m_frameNumber = 0;
+	m_photonProxy.clear();
 
 	// Load (session dependent) fonts
 	hudFont = GFont::fromFile(System::findDataFile(config->hud.hudFont));
@@ -792,21 +897,21 @@ void FPSciApp::updateConfigParameters(const shared_ptr<FpsConfig> config, const
 		}
 
 		// Load static HUD textures
-		for (StaticHudElement element : config->hud.staticElements) {
+		for (const StaticHudElement& element : config->hud.staticElements) {
 			hudTextures.set(element.filename, Texture::fromFile(System::findDataFile(element.filename)));
 		}
 	}
 }
 
 void FPSciApp::quitRequest() {
+	// Stop the hardware event logger (so its last events are written with the session results)
+	if (notNull(m_eventLogger)) {
+		m_eventLogger->stop();
+	}
 	// End session logging
 	if (notNull(sess)) {
 		sess->endLogging();
 	}
-	// Merge Python log into session log (if logging)
-	if (notNull(m_pyLogger)) {
-		m_pyLogger->mergeLogToDb(true);
-	}
     setExitCode(0);
 }
 
@@ -937,6 +1042,7 @@ void FPSciApp::onSimulation(RealTime rdt, SimTime sdt, SimTime idt) {
 	}
 	if (shotFired) {
 		weapon->setLastFireTime(newLastFireTime);
+		m_photonProxy.onShot(m_frameNumber);
 	}
 	weapon->playSound(shotFired, shootButtonUp);
 
@@ -982,8 +1088,8 @@ void FPSciApp::onSimulation(RealTime rdt, SimTime sdt, SimTime idt) {
 		}
 
 		// Handle frame rate/delay updates here
-		if (trialConfig->render.frameRate != lastSetFrameRate || displayLagFrames != trialConfig->render.frameDelay) {
-			updateFrameParameters(trialConfig->render.frameDelay, trialConfig->render.frameRate);
+		if (trialConfig->render.frameRate != lastSetFrameRate || displayLagFrames != trialConfig->render.frameDelay || displayLatencyMs != trialConfig->render.frameDelayMs) {
+			updateFrameParameters(trialConfig->render.frameDelay, trialConfig->render.frameRate, trialConfig->render.frameDelayMs);
 		}
 
 		if (notNull(waypointManager) && notNull(p)) {
@@ -1013,12 +1119,19 @@ void FPSciApp::onSimulation(RealTime rdt, SimTime sdt, SimTime idt) {
 	// Clear button press state
 	shootButtonJustPressed = false;
 	shootButtonJustReleased = false;
+	m_photonProxy.clearInput();
 }
 
 bool FPSciApp::onEvent(const GEvent& event) {
 	GKey ksym = event.key.keysym.sym;
 	bool foundKey = false;
 
+	// Timestamp fire inputs as they arrive (for the software click-to-photon estimate)
+	if ((event.type == GEventType::KEY_DOWN && keyMap.map["shoot"].contains(ksym)) ||
+		(event.type == GEventType::MOUSE_BUTTON_DOWN && keyMap.map["shoot"].contains(GKey(GKey::LEFT_MOUSE + event.button.button)))) {
+		m_photonProxy.onInput(System::time(), EventLogger::hostTime());
+	}
+
 	// Handle developer mode key-bound shortcuts here...
 	if (startupConfig.developerMode) {
 		if (event.type == GEventType::KEY_DOWN) {
@@ -1035,6 +1148,7 @@ bool FPSciApp::onEvent(const GEvent& event) {
 			}
 			else if (keyMap.map["reloadConfigs"].contains(ksym)) {
 				loadConfigs(startupConfig.experimentList[experimentIdx]);					// (Re)load the configs
+				PhysicsScene::clearCache();														// Scene files may have changed on disk
 				// Update session from the reloaded configs
 				m_userSettingsWindow->updateSessionDropDown();
 				updateSession(m_userSettingsWindow->selectedSession());
@@ -1314,7 +1428,7 @@ void FPSciApp::hitTarget(shared_ptr<TargetEntity> target) {
 			m_refTargetHitSound->play(trialConfig->audio.refTargetHitSoundVol);
 		}
 		destroyedTarget = true;
-		sess->accumulatePlayerAction(PlayerActionType::Destroy, target->name());
+		sess->accumulatePlayerAction(PlayerActionType::Destroy, target->registryId());
 	}
 	else if (target->health() <= 0) {
 		// Position explosion
@@ -1324,7 +1438,7 @@ void FPSciApp::hitTarget(shared_ptr<TargetEntity> target) {
 		const shared_ptr<VisibleEntity> newExplosion = VisibleEntity::create(
 			format("explosion%d", m_explosionIdx), 
 			scene().get(), 
-			m_explosionModels.get(target->id())[target->scaleIndex()], 
+			explosionModel(target->id(), target->scaleIndex()), 
 			explosionFrame
 		);
 		m_explosionIdx++;
@@ -1344,11 +1458,11 @@ void FPSciApp::hitTarget(shared_ptr<TargetEntity> target) {
 			destroyedTarget = true;
 		}
 		// Target eliminated, must be 'destroy'.
-		sess->accumulatePlayerAction(PlayerActionType::Destroy, target->name());
+		sess->accumulatePlayerAction(PlayerActionType::Destroy, target->registryId());
 	}
 	else {
 		// Target 'hit', but still alive.
-		sess->accumulatePlayerAction(PlayerActionType::Hit, target->name());
+		sess->accumulatePlayerAction(PlayerActionType::Hit, target->registryId());
 	}
 	if (!destroyedTarget || respawned) {
 		if (respawned) {
@@ -1361,16 +1475,8 @@ void FPSciApp::hitTarget(shared_ptr<TargetEntity> target) {
 
 void FPSciApp::updateTargetColor(const shared_ptr<TargetEntity>& target) {
 	BEGIN_PROFILER_EVENT("updateTargetColor/changeColor");
-	BEGIN_PROFILER_EVENT("updateTargetColor/clone");
-	shared_ptr<ArticulatedModel::Pose> pose = dynamic_pointer_cast<ArticulatedModel::Pose>(target->pose()->clone());
-	END_PROFILER_EVENT();
-	BEGIN_PROFILER_EVENT("updateTargetColor/materialSet");
-	shared_ptr<UniversalMaterial> mat = materials[target->id()][min((int)(target->health() * matTableSize), matTableSize - 1)];
-	pose->materialTable.set("core/icosahedron_default", mat);
-	END_PROFILER_EVENT();
-	BEGIN_PROFILER_EVENT("updateTargetColor/setPose");
-	target->setPose(pose);
-	END_PROFILER_EVENT();
+	// Use the shared pose for this health level (no per-target copy is needed)
+	target->setPose(m_healthPoses[target->id()][min((int)(target->health() * matTableSize), matTableSize - 1)]);
 	END_PROFILER_EVENT();
 }
 
@@ -1514,6 +1620,77 @@ void FPSciApp::setReticle(const int r) {
 void FPSciApp::onCleanup() {
 	// Called after the application loop ends.  Place a majority of cleanup code
 	// here instead of in the constructor so that exceptions can be caught.
+	PhysicsScene::waitForPrefetch();
+	m_passTimer.cleanup();
+}
+
+void FPSciApp::waitForTargetFrameTime(RealTime targetFrameTime) {
+    BEGIN_PROFILER_EVENT("Wait");
+    m_waitWatch.tick(); {
+        RealTime nowAfterLoop = System::time();
+
+        // Compute accumulated time
+        RealTime cumulativeTime = nowAfterLoop - m_lastWaitTime;
+
+        debugAssert(m_wallClockTargetDuration < finf());
+        // Perform wait for target time needed
+        RealTime duration = targetFrameTime;
+        if (!window()->hasFocus() && m_lowerFrameRateInBackground) {
+            // Lower frame rate to 4fps
+            duration = 1.0 / 4.0;
+        }
+        RealTime desiredWaitTime = max(0.0, duration - cumulativeTime);
+        const RealTime waitEndTime = nowAfterLoop + desiredWaitTime;
+
+        const RenderConfig::FramePacing pacing = trialConfig->render.framePacing;
+        if (pacing == RenderConfig::FramePacing::Spin) {
+            // Spin on the (high resolution) system clock for the entire wait
+            while (System::time() < waitEndTime) {}
+        }
+        else if (pacing == RenderConfig::FramePacing::Hybrid) {
+            // Sleep for most of the wait, then spin for the remaining tail
+            const RealTime sleepTime = desiredWaitTime - m_lastFrameOverWait - 0.001 * trialConfig->render.framePacingSpinMs;
+            if (sleepTime > 0.0) {
+                const RealTime sleepStart = System::time();
+                onWait(sleepTime);
+                updateOverWaitEstimate((System::time() - sleepStart) - sleepTime);
+            }
+            while (System::time() < waitEndTime) {}
+        }
+        else {
+            onWait(max(0.0, desiredWaitTime - m_lastFrameOverWait) * 0.97);
+        }
+
+        // Update wait timers
+        const RealTime lastWaitEndTime = m_lastWaitTime;
+        m_lastWaitTime = System::time();
+        RealTime actualWaitTime = m_lastWaitTime - nowAfterLoop;
+
+        // Learn how much onWait appears to overshoot by and compensate
+        double thisOverWait = actualWaitTime - desiredWaitTime;
+        if (pacing == RenderConfig::FramePacing::Sleep) {
+            updateOverWaitEstimate(thisOverWait);
+        }
+
+        // Track the pacing error (actual frame period - target frame time) for the HUD and logging
+        // Frames that overrun their target don't wait, so the wait itself can't measure the error
+        if (lastWaitEndTime > 0.0) {
+            m_lastPacingError = float((m_lastWaitTime - lastWaitEndTime) - duration);
+            m_pacingErrors.add(m_lastPacingError);
+        }
+    }  m_waitWatch.tock();
+    END_PROFILER_EVENT();
+}
+
+void FPSciApp::updateOverWaitEstimate(double thisOverWait) {
+    if (G3D::abs(thisOverWait - m_lastFrameOverWait) / max(G3D::abs(m_lastFrameOverWait), G3D::abs(thisOverWait)) > 0.4) {
+        // Abruptly change our estimate
+        m_lastFrameOverWait = thisOverWait;
+    }
+    else {
+        // Smoothly change our estimate
+        m_lastFrameOverWait = lerp(m_lastFrameOverWait, thisOverWait, 0.1);
+    }
 }
 
 /** Overridden (optimized) oneFrame() function to improve latency */
@@ -1530,39 +1707,7 @@ void FPSciApp::oneFrame() {
     // though, because while we're sleeping the CPU the GPU is working
     // to catch up.    
     if ((submitToDisplayMode() == SubmitToDisplayMode::MINIMIZE_LATENCY)) {
-        BEGIN_PROFILER_EVENT("Wait");
-        m_waitWatch.tick(); {
-            RealTime nowAfterLoop = System::time();
-
-            // Compute accumulated time
-            RealTime cumulativeTime = nowAfterLoop - m_lastWaitTime;
-
-            debugAssert(m_wallClockTargetDuration < finf());
-            // Perform wait for target time needed
-            RealTime duration = targetFrameTime;
-            if (!window()->hasFocus() && m_lowerFrameRateInBackground) {
-                // Lower frame rate to 4fps
-                duration = 1.0 / 4.0;
-            }
-            RealTime desiredWaitTime = max(0.0, duration - cumulativeTime);
-            onWait(max(0.0, desiredWaitTime - m_lastFrameOverWait) * 0.97);
-
-            // Update wait timers
-            m_lastWaitTime = System::time();
-            RealTime actualWaitTime = m_lastWaitTime - nowAfterLoop;
-
-            // Learn how much onWait appears to overshoot by and compensate
-            double thisOverWait = actualWaitTime - desiredWaitTime;
-            if (G3D::abs(thisOverWait - m_lastFrameOverWait) / max(G3D::abs(m_lastFrameOverWait), G3D::abs(thisOverWait)) > 0.4) {
-                // Abruptly change our estimate
-                m_lastFrameOverWait = thisOverWait;
-            }
-            else {
-                // Smoothly change our estimate
-                m_lastFrameOverWait = lerp(m_lastFrameOverWait, thisOverWait, 0.1);
-            }
-        }  m_waitWatch.tock();
-        END_PROFILER_EVENT();
+        waitForTargetFrameTime(targetFrameTime);
     }
 
     for (int repeat = 0; repeat < max(1, m_renderPeriod); ++repeat) {
@@ -1611,6 +1756,10 @@ void FPSciApp::oneFrame() {
 
             SimTime idt = (SimTime)targetFrameTime;
 
+            m_frameInfo.rdt = float(rdt);
+            m_frameInfo.sdt = float(sdt);
+            m_frameInfo.idt = float(idt);
+
             onBeforeSimulation(rdt, sdt, idt);
             onSimulation(rdt, sdt, idt);
             onAfterSimulation(rdt, sdt, idt);
@@ -1645,45 +1794,14 @@ void FPSciApp::oneFrame() {
     // though, because while we're sleeping the CPU the GPU is working
     // to catch up.    
     if ((submitToDisplayMode() != SubmitToDisplayMode::MINIMIZE_LATENCY)) {
-        BEGIN_PROFILER_EVENT("Wait");
-        m_waitWatch.tick(); {
-            RealTime nowAfterLoop = System::time();
-
-            // Compute accumulated time
-            RealTime cumulativeTime = nowAfterLoop - m_lastWaitTime;
-
-            debugAssert(m_wallClockTargetDuration < finf());
-            // Perform wait for actual time needed
-            RealTime duration = targetFrameTime;
-            if (!window()->hasFocus() && m_lowerFrameRateInBackground) {
-                // Lower frame rate to 4fps
-                duration = 1.0 / 4.0;
-            }
-            RealTime desiredWaitTime = max(0.0, duration - cumulativeTime);
-            onWait(max(0.0, desiredWaitTime - m_lastFrameOverWait) * 0.97);
-
-            // Update wait timers
-            m_lastWaitTime = System::time();
-            RealTime actualWaitTime = m_lastWaitTime - nowAfterLoop;
-
-            // Learn how much onWait appears to overshoot by and compensate
-            double thisOverWait = actualWaitTime - desiredWaitTime;
-            if (G3D::abs(thisOverWait - m_lastFrameOverWait) / max(G3D::abs(m_lastFrameOverWait), G3D::abs(thisOverWait)) > 0.4) {
-                // Abruptly change our estimate
-                m_lastFrameOverWait = thisOverWait;
-            }
-            else {
-                // Smoothly change our estimate
-                m_lastFrameOverWait = lerp(m_lastFrameOverWait, thisOverWait, 0.1);
-            }
-        }  m_waitWatch.tock();
-        END_PROFILER_EVENT();
+        waitForTargetFrameTime(targetFrameTime);
     }
 
     // Graphics
     debugAssertGLOk();
     if ((submitToDisplayMode() == SubmitToDisplayMode::BALANCE) && (!renderDevice->swapBuffersAutomatically())) {
         swapBuffers();
+        m_photonProxy.onSubmit(m_frameNumber - 1, System::time(), m_lastAddedLatency);    // This submits the previous frame
     }
 
     if (notNull(m_gazeTracker)) {
@@ -1706,8 +1824,28 @@ void FPSciApp::oneFrame() {
     if ((submitToDisplayMode() == SubmitToDisplayMode::MINIMIZE_LATENCY) && (!renderDevice->swapBuffersAutomatically())) {
         swapBuffers();
     }
+    if ((submitToDisplayMode() != SubmitToDisplayMode::BALANCE) || renderDevice->swapBuffersAutomatically()) {
+        m_photonProxy.onSubmit(m_frameNumber, System::time(), m_lastAddedLatency);
+    }
     END_PROFILER_EVENT();
 
+    // Record the timing for this frame (now that all stages have completed)
+    m_frameInfo.time = FPSciLogger::getFileTime();
+    m_frameInfo.targetFrameTime = float(targetFrameTime);
+    m_frameInfo.pacingError = m_lastPacingError;
+    m_frameInfo.userInputTime = float(m_userInputWatch.elapsedTime());
+    m_frameInfo.networkTime = float(m_networkWatch.elapsedTime());
+    m_frameInfo.logicTime = float(m_logicWatch.elapsedTime());
+    m_frameInfo.simulationTime = float(m_simulationWatch.elapsedTime());
+    m_frameInfo.poseTime = float(m_poseWatch.elapsedTime());
+    m_frameInfo.waitTime = float(m_waitWatch.elapsedTime());
+    m_frameInfo.graphicsTime = float(m_graphicsWatch.elapsedTime());
+    m_frameInfo.delayBufferIndex = m_currentDelayBufferIndex;
+    m_frameInfo.addedLatency = m_lastAddedLatency;
+    sess->accumulateFrameInfo(m_frameInfo);
+    m_photonProxy.takeEstimates(m_latencyEstimates);
+    sess->accumulateLatencyEstimates(m_latencyEstimates);
+
     // Remove all expired debug shapes
     for (int i = 0; i < debugShapeArray.size(); ++i) {
         if (debugShapeArray[i].endTime <= m_now) {
@@ -21,9 +21,17 @@
 #include "TargetEntity.h"
 #include "PlayerEntity.h"
 #include "GuiElements.h"
-#include "PythonLogger.h"
+#include "EventLogger.h"
+#include "PhotonProxy.h"
 #include "Weapon.h"
 #include "CombatText.h"
+#include "FramePacing.h"
+#include "DelayRing.h"
+#include "HudBatch.h"
+#include "TextLayoutCache.h"
+#include "ShaderPassGraph.h"
+#include "PassTimer.h"
+#include "Session.h"
 
 class Session;
 class DialogBase;
@@ -59,7 +67,7 @@ public:
 	};
 
 protected:
-	static const int						MAX_HISTORY_TIMING_FRAMES = 360;	///< Length of the history queue for m_frameDurationQueue
+	static const int						MAX_HISTORY_TIMING_FRAMES = 360;	///< Length of the history window for m_frameDurations
 	shared_ptr<Sound>						m_sceneHitSound;					///< Sound for scene collision
 	shared_ptr<Sound>						m_refTargetHitSound;				///< Sound for hitting the reference target
 
@@ -71,17 +79,42 @@ protected:
 	int										m_explosionIdx = 0;					///< Explosion index
 	const int								m_maxExplosions = 20;				///< Maximum number of simultaneous explosions
 	
-	Table<String, Array<shared_ptr<ArticulatedModel>>> m_explosionModels;
+	Table<String, String>					m_targetModelKeys;					///< Target model spec key (unparsed spec, scaled to 1m) by target id
+	Table<String, String>					m_explosionModelKeys;				///< Explosion model spec key by target id
+	Table<String, Any>						m_modelSpecs;						///< Base (scale index independent) model specs by key
+	Table<String, Array<shared_ptr<ArticulatedModel::Pose>>> m_healthPoses;	///< Poses (one per health level) by target id
+
+	/** Material tables and their poses, keyed by the resolved color spec (shared across sessions) */
+	Table<String, Array<shared_ptr<UniversalMaterial>>>			m_materialCache;
+	Table<String, Array<shared_ptr<ArticulatedModel::Pose>>>	m_poseCache;
+
+	/** Models built for each scale index, keyed by model spec key so target types can share them */
+	Table<String, Array<shared_ptr<ArticulatedModel>>> m_scaledModels;
 	/** table of shaders cached for the 2D shader parameters set per session */
 	Table<String, shared_ptr<G3D::Shader>> m_shaderTable;
 
 	/** Used for visualizing history of frame times. Temporary, awaiting a G3D built-in that does this directly with a texture. */
-	Queue<float>							m_frameDurationQueue;				///< Queue for history of frame times
+	FrameTimeWindow							m_frameDurations = FrameTimeWindow(MAX_HISTORY_TIMING_FRAMES);	///< Window of recent frame times (with min/max)
+	TextLayoutCache							m_textLayouts;						///< Cached glyph geometry for text drawn every frame
+	static constexpr RealTime				STATS_TEXT_PERIOD_S = 0.25;			///< Period for updating the FPS indicator statistics text (so its layouts aren't rebuilt every frame)
+	RealTime								m_lastStatsTextTime = -finf();		///< Time the FPS indicator statistics text was last updated
+	String									m_fpsText;							///< FPS indicator text
+	String									m_pacingText;						///< Frame pacing statistics text
+	String									m_clickToPhotonText;				///< Click-to-photon latency statistics text
+	String									m_passTimesText;					///< Render pass times text
+	int										m_feedbackLineCount = 0;			///< Number of lines in the current feedback message
+	String									m_feedbackMessage;					///< Feedback message m_feedbackLineCount was computed for
 
 	/** Used to detect GUI changes to m_reticleIndex */
 	int										m_lastReticleLoaded = -1;			///< Last loaded reticle (used for change detection)
 	float									m_debugMenuHeight = 0.0f;			///< Height of the debug menu when in developer mode
 
+	FramePacingHistogram					m_pacingErrors;						///< Histogram of frame pacing error (reset each session)
+	float									m_lastPacingError = 0.0f;			///< Frame pacing error (actual frame period - target frame time) for the last frame
+	PassTimer								m_passTimer;						///< Per-pass (GPU) render timing (samples reset each trial)
+	bool									m_timing3D = false;					///< Is the "3D" pass currently being timed?
+	FrameInfo								m_frameInfo;						///< Timing info for the current frame (reused every frame)
+
 	RealTime								m_lastJumpTime = 0.0f;				///< Time of last jump
 	SimTime									m_lastSdt;							///< Last sim delta time
 public:
@@ -97,11 +130,19 @@ protected:
 
 	String									m_expConfigHash;					///< String hash of experiment config file
 
-	shared_ptr<PythonLogger>				m_pyLogger = nullptr;
+	shared_ptr<EventLogger>					m_eventLogger = nullptr;			///< Hardware click-to-photon event logger (when present)
+
+	/** When m_displayLagFrames > 0 (or displayLatencyMs > 0), 3D frames are delayed in this ring */
+	DelayRing<shared_ptr<Framebuffer>>		m_ldrDelayRing;
+	int										m_currentDelayBufferIndex = 0;		///< Index (0 = oldest) of the delay buffer presented for the last frame
+	float									m_lastAddedLatency = 0.0f;			///< Latency (in seconds) added by the delay buffers for the last frame
+	float									m_delayRingLatencyMs = 0.0f;		///< Latency (in ms) the delay ring was last sized for
+	static const size_t						MAX_DELAY_BUFFER_BYTES = 512 * 1024 * 1024;	///< Maximum (approximate) memory held by delay buffers for displayLatencyMs
+
+	PhotonProxy								m_photonProxy;						///< Software click-to-photon latency estimate (per shot)
+	Array<PhotonProxy::Estimate>			m_latencyEstimates;					///< Completed estimates for the current frame
 
-	/** When m_displayLagFrames > 0, 3D frames are delayed in this queue */
-	Array<shared_ptr<Framebuffer>>			m_ldrDelayBufferQueue;
-	int										m_currentDelayBufferIndex = 0;
+	HudBatch								m_hudBatch;							///< Solid HUD geometry (batched into a single draw)
 
     shared_ptr<UserMenu>					m_userSettingsWindow;				///< User settings window
 	MouseInputMode							m_mouseInputMode = MouseInputMode::MOUSE_CURSOR;	///< Does the mouse currently have control over the view
@@ -119,11 +160,16 @@ protected:
 
 	// Shader buffers
 	shared_ptr<Framebuffer>					m_ldrBuffer2D;						///< Buffer to use for 2D content (if split)
-	shared_ptr<Framebuffer>					m_ldrShader2DOutput;				///< Buffer to use for 2D shader output (if provided)
-	shared_ptr<Framebuffer>					m_hdrShader3DOutput;				///< Buffer to use for 3D shader output (if provided)
 	shared_ptr<Framebuffer>					m_ldrBufferPrecomposite;			///< Buffer to blit LDR framebuffer into before converting to composite resolution
 	shared_ptr<Framebuffer>					m_ldrBufferComposite;				///< Buffer to use for input to composited shader (if provided)
-	shared_ptr<Framebuffer>					m_ldrShaderCompositeOutput;			///< Buffer to use for composite shader output (if provided)
+
+	// Shader pass graphs (and their transient targets) for each stage
+	ShaderPassGraph							m_shaderGraph3D;					///< Passes run on the (HDR) 3D framebuffer
+	ShaderPassGraph							m_shaderGraph2D;					///< Passes run on the 2D buffer
+	ShaderPassGraph							m_shaderGraphComposite;				///< Passes run on the composite buffer
+	Array<shared_ptr<Framebuffer>>			m_shaderTargets3D;					///< Targets for the 3D shader passes
+	Array<shared_ptr<Framebuffer>>			m_shaderTargets2D;					///< Targets for the 2D shader passes
+	Array<shared_ptr<Framebuffer>>			m_shaderTargetsComposite;			///< Targets for the composite shader passes
 
 	// Shader parameters
 	int										m_frameNumber = 0;					///< Frame number (since the start of the session)
@@ -137,6 +183,8 @@ protected:
 	void loadConfigs(const ConfigFiles& configs);
 
 	virtual void loadModels();
+	/** Get (or build) the model for a spec at a given scale index */
+	shared_ptr<ArticulatedModel> scaledModel(const String& specKey, const int scaleIdx);
 	
 	/** Initializes player settings from configs and resets player to initial position 
 		Also updates mouse sensitivity. */
@@ -154,6 +202,11 @@ protected:
 	/** Set the scoped view (and also adjust the turn scale), use setScopeView(!weapon->scoped()) to toggle scope */
 	void setScopeView(bool scoped = true);
 
+	/** Wait for the target frame time using the configured frame pacing strategy */
+	void waitForTargetFrameTime(RealTime targetFrameTime);
+	/** Update the (smoothed) estimate of how much onWait() overshoots by */
+	void updateOverWaitEstimate(double thisOverWait);
+
 	void hitTarget(shared_ptr<TargetEntity> target);
 	void missEvent();
 
@@ -195,7 +248,12 @@ public:
 	shared_ptr<DialogBase>			dialog;							///< Dialog box
 	Question						currentQuestion;				///< Currently presented question
 
-	Table<String, Array<shared_ptr<ArticulatedModel>>>	targetModels;
+	/** Get the target/explosion model for a target id at a given scale index (built on first use) */
+	shared_ptr<ArticulatedModel> targetModel(const String& id, const int scaleIdx);
+	shared_ptr<ArticulatedModel> explosionModel(const String& id, const int scaleIdx);
+	bool hasTargetModel(const String& id) const { return m_targetModelKeys.containsKey(id); }
+	/** Build the target/explosion models for all scale indices within a size range */
+	void buildTargetModels(const String& id, const float minSize, const float maxSize);
 
 	/** A table of sounds that targets can use to allow sounds to finish playing after they're destroyed */
 	Table<String, shared_ptr<Sound>>					soundTable;
@@ -204,7 +262,8 @@ public:
 	Table<String, Array<shared_ptr<UniversalMaterial>>>	materials;
 	const int											matTableSize = 13;	///< Set this to set # of color "levels"
 	
-	Array<shared_ptr<UniversalMaterial>> makeMaterials(shared_ptr<TargetConfig> tconfig);
+	/** Update the materials (and health poses) for a target id, reusing tables already built for the same colors */
+	void updateMaterials(const String& id, shared_ptr<TargetConfig> tconfig);
 	Color4 lerpColor(Array<Color4> colors, float a);
 
 	shared_ptr<Session> sess;					///< Pointer to the experiment
@@ -213,6 +272,7 @@ public:
 
 	bool		renderFPS			= false;	///< Control flag used to draw (or not draw) FPS information to the display	
 	int			displayLagFrames	= 0;		///< Count of frames of latency to add
+	float		displayLatencyMs	= 0.0f;		///< Display latency (in ms) to add (used instead of displayLagFrames when > 0)
 	float		lastSetFrameRate	= 0.0f;		///< Last set frame rate
 	const int	numReticles			= 55;		///< Total count of reticles available to choose from
 	float		sceneBrightness		= 1.0f;		///< Scene brightness scale factor
@@ -239,6 +299,16 @@ public:
 	/** Save scene w/ updated player position */
 	void exportScene();
 
+	/** Frame pacing error (actual - desired wait time, in seconds) for the last frame */
+	float lastPacingError() const { return m_lastPacingError; }
+	const FramePacingHistogram& pacingErrors() const { return m_pacingErrors; }
+	/** Per-pass render timing (samples are cleared as each trial is logged) */
+	PassTimer& passTimer() { return m_passTimer; }
+	/** Hardware click-to-photon event logger (null when no logger is present) */
+	shared_ptr<EventLogger> eventLogger() const { return m_eventLogger; }
+	/** Get the hash of the (serialized) experiment config, computed once when it is loaded */
+	const String& experimentConfigHash() const { return m_expConfigHash; }
+
 	float debugMenuHeight() {
 		return m_debugMenuHeight;
 	}
@@ -262,8 +332,10 @@ public:
 	/** Updates experiment state to the provided session id and updates player parameters (including mouse sensitivity) */
 	virtual void updateSession(const String& id, bool forceSceneReload = false);
 	void updateTrial(const shared_ptr<TrialConfig> config, const bool forceSceneReload = false, const bool respawn = false);
+	/** Start reading the next session's scene from disk in the background (called during session feedback) */
+	void prefetchNextScene();
 	void updateConfigParameters(const shared_ptr<FpsConfig> config, bool forceSceneReload = false, const bool respawn = false, const bool trialLevel = true);
-	void updateFrameParameters(int frameDelay, float frameRate);
+	void updateFrameParameters(int frameDelay, float frameRate, float frameDelayMs = 0.0f);
 	void updateTargetColor(const shared_ptr<TargetEntity>& target);
 	void presentQuestion(Question question);
 
@@ -303,21 +375,33 @@ public:
 	virtual void onGraphics2D(RenderDevice* rd, Array<shared_ptr<Surface2D> >& surface2D) override;
 	virtual void onGraphics3D(RenderDevice* rd, Array<shared_ptr<Surface> >& surface) override;
 	virtual void onPostProcessHDR3DEffects(RenderDevice* rd) override;
+	/** End the "3D" pass timer (if running), called before the 3D shader passes so they are only timed in their own passes */
+	void endTiming3D();
 	
 	void draw2DElements(RenderDevice* rd, Vector2 resolution);			///< Draw the undelayed 2D elements
 	void drawDelayed2DElements(RenderDevice* rd, Vector2 resolution);	///< Draw the delayed 2D elements
 
 	virtual void drawHUD(RenderDevice* rd, Vector2 resolution);						///< Draw HUD elements
-	void drawClickIndicator(RenderDevice* rd, String mode, Vector2 resolution);		///< Draw the click-to-photon click indicator
+	void drawClickIndicator(RenderDevice* rd, ClickToPhotonConfig::Mode mode, Vector2 resolution);		///< Draw the click-to-photon click indicator
 	void updateFPSIndicator(RenderDevice* rd, Vector2 resolution);					///< Update and draw a (custom) frame time indicator (developer mode feature)
 	void drawFeedbackMessage(RenderDevice* rd);										///< Draw a user feedback message (at full render device resolution)
 
 	void updateShaderBuffers(const shared_ptr<FpsConfig> config);									///< Regenerate buffers (for configured shaders)
-
-	/** calls rd->pushState with the right delayed buffer. Creates buffers if needed */
-	void pushRdStateWithDelay(RenderDevice* rd, Array<shared_ptr<Framebuffer>> &delayBufferQueue, int &delayIndex, int lagFrames = 0);
-	/** calls rd->popState and advances the delayIndex. Copies the latest delay buffer into the current framebuffer */
-	void popRdStateWithDelay(RenderDevice* rd, const Array<shared_ptr<Framebuffer>> &delayBufferQueue, int& delayIndex, int lagFrames = 0);
+	/** Create the (transient) render targets required by a shader pass graph */
+	void allocateShaderTargets(const ShaderPassGraph& graph, Array<shared_ptr<Framebuffer>>& targets, const ImageFormat* imageFormat, const String& prefix);
+	/** Run the passes of a shader stage, returns the texture holding the output (or nullptr if the last pass wrote the current framebuffer) */
+	shared_ptr<Texture> runShaderStage(RenderDevice* rd, const ShaderPassGraph& graph, const Array<shared_ptr<Framebuffer>>& targets, const shared_ptr<Texture>& input, RealTime& lastTime);
+
+	/** calls rd->pushState with the next delay buffer. Buffers are created lazily and released when lagFrames drops */
+	void pushRdStateWithDelay(RenderDevice* rd, int lagFrames = 0);
+	/** calls rd->popState and copies the oldest delay buffer into the current framebuffer */
+	void popRdStateWithDelay(RenderDevice* rd, int lagFrames = 0);
+	/** Get the delay buffer to render the current frame into (reallocating it if the resolution has changed) */
+	shared_ptr<Framebuffer> beginDelayedFrame(RenderDevice* rd);
+	/** calls rd->pushState with the next (timestamped) delay buffer. Sizes the queue from the frame rate and latency */
+	void pushRdStateWithLatency(RenderDevice* rd, float latencyMs);
+	/** calls rd->popState and copies the newest delay buffer at least latencyMs old into the current framebuffer */
+	void popRdStateWithLatency(RenderDevice* rd, float latencyMs);
 
 };
 
@@ -7,38 +7,31 @@ void FPSciApp::updateShaderBuffers(const shared_ptr<FpsConfig> config) {
 	int width = renderDevice->width();
 	int height = renderDevice->height();
 
-	// 2D buffers (input and output) used when 2D resolution or shader is specified
-	if (!config->render.shader2D.empty() || config->render.resolution2D[0] > 0) {
+	// 2D buffer (input) used when 2D resolution or shader pass(es) are specified
+	const Array<ShaderPassConfig> passes2D = config->render.stagePasses("2D");
+	if (passes2D.size() > 0 || config->render.resolution2D[0] > 0) {
 		if (config->render.resolution2D[0] > 0) {
 			width = config->render.resolution2D[0];
 			height = config->render.resolution2D[1];
 		}
 		m_ldrBuffer2D = Framebuffer::create(Texture::createEmpty("FPSci::2DShaderPass::Input", width, height, 
 			ImageFormat::RGBA8(), Texture::DIM_2D, true));
-		m_ldrShader2DOutput = Framebuffer::create(Texture::createEmpty("FPSci::2DShaderPass::Output", width, height, 
-			ImageFormat::RGBA8(), Texture::DIM_2D, true));
 	}
 	else {
 		m_ldrBuffer2D.reset();
-		m_ldrShader2DOutput.reset();
 	}
+	// The 2D stage output is always (alpha blended) into the framebuffer/composite input, so never write it directly
+	m_shaderGraph2D.build(passes2D, width, height);
+	allocateShaderTargets(m_shaderGraph2D, m_shaderTargets2D, ImageFormat::RGBA8(), "FPSci::2DShaderPass");
 
-	// 3D shader output (use popped framebuffer as input) used when 3D resolution or shader is specified
-	if (!config->render.shader3D.empty() || config->render.resolution3D[0] > 0) {
-		width = m_framebuffer->width(); height = m_framebuffer->height();
-		if (config->render.resolution3D[0] > 0) {
-			width = config->render.resolution3D[0];
-			height = config->render.resolution3D[1];
-		}
-		m_hdrShader3DOutput = Framebuffer::create(Texture::createEmpty("FPSci::3DShaderPass::Output", width, height, 
-			m_framebuffer->texture(0)->format(), Texture::DIM_2D, true));
-	}
-	else {
-		m_hdrShader3DOutput.reset();
-	}
+	// 3D shader passes (use popped framebuffer as input/output)
+	width = m_framebuffer->width(); height = m_framebuffer->height();
+	m_shaderGraph3D.build(config->render.stagePasses("3D"), width, height, width, height, true);
+	allocateShaderTargets(m_shaderGraph3D, m_shaderTargets3D, m_framebuffer->texture(0)->format(), "FPSci::3DShaderPass");
 
-	// Composite buffer (input and output) used when composite shader or resolution is specified
-	if (!config->render.shaderComposite.empty() || config->render.resolutionComposite[0] > 0) {
+	// Composite buffer (input) used when composite shader pass(es) or resolution is specified
+	const Array<ShaderPassConfig> passesComposite = config->render.stagePasses("composite");
+	if (passesComposite.size() > 0 || config->render.resolutionComposite[0] > 0) {
 		width = renderDevice->width(); height = renderDevice->height();
 		m_ldrBufferPrecomposite = Framebuffer::create(Texture::createEmpty("FPSci::CompositeShaderPass::Precomposite", width, height, 
 			ImageFormat::RGB8(), Texture::DIM_2D, true));
@@ -48,18 +41,62 @@ void FPSciApp::updateShaderBuffers(const shared_ptr<FpsConfig> config) {
 		}
 		m_ldrBufferComposite = Framebuffer::create(Texture::createEmpty("FPSci::CompositeShaderPass::Input", width, height, 
 			ImageFormat::RGB8(), Texture::DIM_2D, true));
-		m_ldrShaderCompositeOutput = Framebuffer::create(Texture::createEmpty("FPSci::CompositeShaderPass::Output", width, height, 
-			ImageFormat::RGB8(), Texture::DIM_2D, true));
+		m_shaderGraphComposite.build(passesComposite, width, height, renderDevice->width(), renderDevice->height());
 	}
 	else {
 		m_ldrBufferPrecomposite.reset();
 		m_ldrBufferComposite.reset();
-		m_ldrShaderCompositeOutput.reset();
+		m_shaderGraphComposite.clear();
+	}
+	allocateShaderTargets(m_shaderGraphComposite, m_shaderTargetsComposite, ImageFormat::RGB8(), "FPSci::CompositeShaderPass");
+}
+
+void FPSciApp::allocateShaderTargets(const ShaderPassGraph& graph, Array<shared_ptr<Framebuffer>>& targets, const ImageFormat* imageFormat, const String& prefix) {
+	targets.fastClear();
+	for (int i = 0; i < graph.targets().size(); i++) {
+		const ShaderPassGraph::Target& target = graph.targets()[i];
+		targets.append(Framebuffer::create(Texture::createEmpty(format("%s::Target%d", prefix.c_str(), i), target.width, target.height,
+			imageFormat, Texture::DIM_2D, true)));
+	}
+}
+
+shared_ptr<Texture> FPSciApp::runShaderStage(RenderDevice* rd, const ShaderPassGraph& graph, const Array<shared_ptr<Framebuffer>>& targets, const shared_ptr<Texture>& input, RealTime& lastTime) {
+	const float iTime = float(System::time() - m_startTime);
+	shared_ptr<Texture> output = input;
+	for (const ShaderPassGraph::Pass& pass : graph.passes()) {
+		const ShaderPassConfig& config = graph.config(pass);
+		m_passTimer.begin(pass.timerName);
+		const shared_ptr<Texture> source = pass.input == ShaderPassGraph::STAGE_INPUT ? input : targets[pass.input]->texture(0);
+		const shared_ptr<Framebuffer> target = pass.output == ShaderPassGraph::STAGE_OUTPUT ? nullptr : targets[pass.output];
+
+		// Passes writing the stage output render into the current framebuffer
+		isNull(target) ? rd->push2D() : rd->push2D(target); {
+			if (config.shader.empty()) {
+				// No shader specified, just resample the input
+				Draw::rect2D(rd->viewport(), rd, Color3::white(), source, config.sampler);
+			}
+			else {
+				// Setup shadertoy-style args
+				Args args;
+				args.setUniform("iChannel0", source, config.sampler);
+				args.setUniform("iTime", iTime);
+				args.setUniform("iTimeDelta", iTime - float(lastTime));
+				args.setUniform("iMouse", userInput->mouseXY());
+				args.setUniform("iFrame", m_frameNumber);
+				args.setRect(rd->viewport());
+				LAUNCH_SHADER_PTR(m_shaderTable[config.shader], args);
+			}
+		} rd->pop2D();
+		m_passTimer.end(pass.timerName);
+		output = isNull(target) ? nullptr : target->texture(0);
 	}
+	lastTime = iTime;
+	return output;
 }
 
 void FPSciApp::onGraphics(RenderDevice* rd, Array<shared_ptr<Surface> >& posed3D, Array<shared_ptr<Surface2D> >& posed2D) {
 	debugAssertGLOk();
+	m_passTimer.beginFrame();
 
 	rd->pushState(); {
 		debugAssert(notNull(activeCamera()));
@@ -84,10 +121,15 @@ void FPSciApp::onGraphics(RenderDevice* rd, Array<shared_ptr<Surface> >& posed3D
 
 void FPSciApp::onGraphics3D(RenderDevice* rd, Array<shared_ptr<Surface> >& surface) {
 
-	pushRdStateWithDelay(rd, m_ldrDelayBufferQueue, m_currentDelayBufferIndex, displayLagFrames);
+	if (displayLatencyMs > 0.0f) pushRdStateWithLatency(rd, displayLatencyMs);
+	else pushRdStateWithDelay(rd, displayLagFrames);
 
 	// Tone mapping from HDR --> LDR happens at the end of this call (after onPostProcessHDR3DEffects() call)
+	// The "3D" timer is ended before the 3D shader passes (in onPostProcessHDR3DEffects()) so they aren't counted twice
+	m_passTimer.begin("3D");
+	m_timing3D = true;
 	GApp::onGraphics3D(rd, surface);
+	endTiming3D();
 
 	// Draw 2D game elements to be delayed
 	if (notNull(m_ldrBuffer2D)) {
@@ -100,10 +142,15 @@ void FPSciApp::onGraphics3D(RenderDevice* rd, Array<shared_ptr<Surface> >& surfa
 		isNull(m_ldrBuffer2D) ?
 			rd->setBlendFunc(RenderDevice::BLEND_SRC_ALPHA, RenderDevice::BLEND_ONE_MINUS_SRC_ALPHA) :		// Drawing into framebuffer
 			rd->setBlendFunc(RenderDevice::BLEND_ONE, RenderDevice::BLEND_ZERO);							// Drawing into buffer 2D (don't alpha blend)
+		m_passTimer.begin("2D Delayed");
 		drawDelayed2DElements(rd, resolution);
+		m_passTimer.end("2D Delayed");
 	}rd->pop2D();
 
-	popRdStateWithDelay(rd, m_ldrDelayBufferQueue, m_currentDelayBufferIndex, displayLagFrames);
+	m_passTimer.begin("Delay Blit");
+	if (displayLatencyMs > 0.0f) popRdStateWithLatency(rd, displayLatencyMs);
+	else popRdStateWithDelay(rd, displayLagFrames);
+	m_passTimer.end("Delay Blit");
 
 	// Transfer LDR framebuffer to the composite buffer (if used)
 	if (m_ldrBufferComposite) {
@@ -116,38 +163,26 @@ void FPSciApp::onGraphics3D(RenderDevice* rd, Array<shared_ptr<Surface> >& surfa
 	}
 }
  
-void FPSciApp::onPostProcessHDR3DEffects(RenderDevice* rd) {
-	if (notNull(m_hdrShader3DOutput)) {
-		if(trialConfig->render.shader3D.empty()) {
-			// No shader specified, just a resize perform pass through into 3D output buffer from framebuffer
-			rd->push2D(m_hdrShader3DOutput); {
-				Draw::rect2D(rd->viewport(), rd, Color3::white(), m_framebuffer->texture(0), trialConfig->render.sampler3D);
-			} rd->pop2D();
-		}
-		else {
-			BEGIN_PROFILER_EVENT_WITH_HINT("3D Shader Pass", "Time to run the post-3D shader pass");
+void FPSciApp::endTiming3D() {
+	if (m_timing3D) {
+		m_passTimer.end("3D");
+		m_timing3D = false;
+	}
+}
 
-				rd->push2D(m_hdrShader3DOutput); {
-				// Setup shadertoy-style args
-				Args args;
-				args.setUniform("iChannel0", m_framebuffer->texture(0), trialConfig->render.sampler3D);
-				const float iTime = float(System::time() - m_startTime);
-				args.setUniform("iTime", iTime);
-				args.setUniform("iTimeDelta", iTime - m_lastTime);
-				args.setUniform("iMouse", userInput->mouseXY());
-				args.setUniform("iFrame", m_frameNumber);
-				args.setRect(rd->viewport());
-				LAUNCH_SHADER_PTR(m_shaderTable[trialConfig->render.shader3D], args);
-				m_lastTime = iTime;
+void FPSciApp::onPostProcessHDR3DEffects(RenderDevice* rd) {
+	endTiming3D();
+	if (m_shaderGraph3D.passes().size() > 0) {
+		BEGIN_PROFILER_EVENT_WITH_HINT("3D Shader Pass", "Time to run the post-3D shader pass(es)");
+		const shared_ptr<Texture> output = runShaderStage(rd, m_shaderGraph3D, m_shaderTargets3D, m_framebuffer->texture(0), m_last3DTime);
+		END_PROFILER_EVENT();
+
+		// Resample the stage output into the framebuffer (unless the last pass wrote it directly)
+		if (notNull(output)) {
+			rd->push2D(); {
+				Draw::rect2D(rd->viewport(), rd, Color3::white(), output, trialConfig->render.sampler3DOutput);
 			} rd->pop2D();
-
-			END_PROFILER_EVENT();
 		}
-
-		// Resample the shader output buffer into the framebuffer
-		rd->push2D(); {
-			Draw::rect2D(rd->viewport(), rd, Color3::white(), m_hdrShader3DOutput->texture(0), trialConfig->render.sampler3DOutput);
-		} rd->pop2D();
 	}
 
 	GApp::onPostProcessHDR3DEffects(rd);
@@ -161,68 +196,41 @@ void FPSciApp::onGraphics2D(RenderDevice* rd, Array<shared_ptr<Surface2D>>& pose
 		target != m_ldrBuffer2D || isNull(target) ?
 			rd->setBlendFunc(RenderDevice::BLEND_SRC_ALPHA, RenderDevice::BLEND_ONE_MINUS_SRC_ALPHA) :		// Drawing into buffer w/ contents
 			rd->setBlendFunc(RenderDevice::BLEND_ONE, RenderDevice::BLEND_ZERO);							// Drawing into 2D buffer (don't alpha blend)
+		m_passTimer.begin("2D");
 		draw2DElements(rd, resolution);
+		m_passTimer.end("2D");
 	} rd->pop2D();
 
 	if(notNull(m_ldrBuffer2D)){
-		if (trialConfig->render.shader2D.empty()) {
-			m_ldrShader2DOutput = m_ldrBuffer2D;		// Redirect output pointer to input (skip shading)
-		}
-		else {
-			BEGIN_PROFILER_EVENT_WITH_HINT("2D Shader Pass", "Time to run the post-2D shader pass");
-			rd->push2D(m_ldrShader2DOutput); {
-				// Setup shadertoy-style args
-				Args args;
-				args.setUniform("iChannel0", m_ldrBuffer2D->texture(0), trialConfig->render.sampler2D);
-				const float iTime = float(System::time() - m_startTime);
-				args.setUniform("iTime", iTime);
-				args.setUniform("iTimeDelta", iTime - m_last2DTime);
-				args.setUniform("iMouse", userInput->mouseXY());
-				args.setUniform("iFrame", m_frameNumber);
-				args.setRect(rd->viewport());
-				LAUNCH_SHADER_PTR(m_shaderTable[trialConfig->render.shader2D], args);
-				m_last2DTime = iTime;
-			} rd->pop2D();
+		shared_ptr<Texture> output2D = m_ldrBuffer2D->texture(0);
+		if (m_shaderGraph2D.passes().size() > 0) {
+			BEGIN_PROFILER_EVENT_WITH_HINT("2D Shader Pass", "Time to run the post-2D shader pass(es)");
+			output2D = runShaderStage(rd, m_shaderGraph2D, m_shaderTargets2D, m_ldrBuffer2D->texture(0), m_last2DTime);
 			END_PROFILER_EVENT();
 		}
 
 		// Direct shader output to the display or composite shader input (if specified)
 		isNull(m_ldrBufferComposite) ? rd->push2D() : rd->push2D(m_ldrBufferComposite); {
 			rd->setBlendFunc(RenderDevice::BLEND_SRC_ALPHA, RenderDevice::BLEND_ONE_MINUS_SRC_ALPHA);
-			Draw::rect2D(rd->viewport(), rd, Color3::white(), m_ldrShader2DOutput->texture(0), trialConfig->render.sampler2DOutput);
+			Draw::rect2D(rd->viewport(), rd, Color3::white(), output2D, trialConfig->render.sampler2DOutput);
 		} rd->pop2D();
 	}
 
-	//  Handle post-2D composite shader here
+	//  Handle post-2D composite shader pass(es) here
 	if (m_ldrBufferComposite) {
-		if (trialConfig->render.shaderComposite.empty()) {
-			m_ldrShaderCompositeOutput = m_ldrBufferComposite;		// Redirect output pointer to input
+		shared_ptr<Texture> outputComposite = m_ldrBufferComposite->texture(0);
+		if (m_shaderGraphComposite.passes().size() > 0) {
+			BEGIN_PROFILER_EVENT_WITH_HINT("Composite Shader Pass", "Time to run the composite shader pass(es)");
+			outputComposite = runShaderStage(rd, m_shaderGraphComposite, m_shaderTargetsComposite, m_ldrBufferComposite->texture(0), m_lastCompositeTime);
+			END_PROFILER_EVENT();
 		}
-		else {
-			// Run a composite shader
-			BEGIN_PROFILER_EVENT_WITH_HINT("Composite Shader Pass", "Time to run the composite shader pass");
 
-			rd->push2D(m_ldrShaderCompositeOutput); {
-				// Setup shadertoy-style args
-				Args args;
-				args.setUniform("iChannel0", m_ldrBufferComposite->texture(0), trialConfig->render.samplerComposite);
-				const float iTime = float(System::time() - m_startTime);
-				args.setUniform("iTime", iTime);
-				args.setUniform("iTimeDelta", iTime - m_lastCompositeTime);
-				args.setUniform("iMouse", userInput->mouseXY());
-				args.setUniform("iFrame", m_frameNumber);
-				args.setRect(rd->viewport());
-				LAUNCH_SHADER_PTR(m_shaderTable[trialConfig->render.shaderComposite], args);
-				m_lastCompositeTime = iTime;
+		// Copy the stage output into the framebuffer (unless the last pass wrote it directly)
+		if (notNull(outputComposite)) {
+			rd->push2D(); {
+				Draw::rect2D(rd->viewport(), rd, Color3::white(), outputComposite, trialConfig->render.samplerFinal);
 			} rd->pop2D();
-
-			END_PROFILER_EVENT();
 		}
-
-		// Copy the shader output buffer into the framebuffer
-		rd->push2D(); {
-			Draw::rect2D(rd->viewport(), rd, Color3::white(), m_ldrShaderCompositeOutput->texture(0), trialConfig->render.samplerFinal);
-		} rd->pop2D();
 	}
 
 	// Non-scaled content is rendered here
@@ -232,39 +240,81 @@ void FPSciApp::onGraphics2D(RenderDevice* rd, Array<shared_ptr<Surface2D>>& pose
 	Surface2D::sortAndRender(rd, posed2D);
 }
 
-void FPSciApp::pushRdStateWithDelay(RenderDevice* rd, Array<shared_ptr<Framebuffer>> &delayBufferQueue, int &delayIndex, int lagFrames) {
+shared_ptr<Framebuffer> FPSciApp::beginDelayedFrame(RenderDevice* rd) {
+	shared_ptr<Framebuffer>& buffer = m_ldrDelayRing.beginFrame(System::time());
+	// Reuse the buffer unless the resolution has changed
+	if (buffer->width() != rd->width() || buffer->height() != rd->height()) {
+		buffer = Framebuffer::create(Texture::createEmpty(buffer->name(), rd->width(), rd->height(), ImageFormat::RGB8()));
+	}
+	return buffer;
+}
 
+void FPSciApp::pushRdStateWithDelay(RenderDevice* rd, int lagFrames) {
+	// Need one more frame in the ring than we have frames of delay, to hold the current frame (releases buffers when the lag drops)
+	m_ldrDelayRing.setCapacity(lagFrames > 0 ? lagFrames + 1 : 0);
 	if (lagFrames > 0) {
-		// Need one more frame in the queue than we have frames of delay, to hold the current frame
-		if (delayBufferQueue.size() <= lagFrames) {
-			// Allocate new textures
-			for (int i = lagFrames - delayBufferQueue.size(); i >= 0; --i) {
-				delayBufferQueue.push(Framebuffer::create(Texture::createEmpty(format("Delay buffer %d", delayBufferQueue.size()), rd->width(), rd->height(), ImageFormat::RGB8())));
-			}
-			debugAssert(delayBufferQueue.size() == lagFrames + 1);
-		}
-
-		// When the display lag changes, we must be sure to be within range
-		delayIndex = min(lagFrames, delayIndex);
-
-		rd->pushState(delayBufferQueue[delayIndex]);
+		// Render directly into the ring slot for this frame
+		rd->pushState(beginDelayedFrame(rd));
+	}
+	else {
+		m_lastAddedLatency = 0.0f;
 	}
 }
 
-void FPSciApp::popRdStateWithDelay(RenderDevice* rd, const Array<shared_ptr<Framebuffer>> &delayBufferQueue, int& delayIndex, int lagFrames) {
+void FPSciApp::popRdStateWithDelay(RenderDevice* rd, int lagFrames) {
 
 	if (lagFrames > 0) {
 		// Display the delayed frame
 		rd->popState();
 		// Render into the frame buffer or the composite shader input buffer (if provided)
 		rd->push2D(); {
-			// Advance the pointer to the next, which is also the oldest frame
-			delayIndex = (delayIndex + 1) % (lagFrames + 1);
-			Draw::rect2D(rd->viewport(), rd, Color3::white(), delayBufferQueue[delayIndex]->texture(0), Sampler::buffer());
+			// The oldest frame is the delayed one (the ring may not be full yet after the lag changes)
+			m_currentDelayBufferIndex = 0;
+			Draw::rect2D(rd->viewport(), rd, Color3::white(), m_ldrDelayRing.oldest()->texture(0), Sampler::buffer());
+			m_lastAddedLatency = float(m_ldrDelayRing.time(m_ldrDelayRing.size() - 1) - m_ldrDelayRing.time(0));
 		} rd->pop2D();
 	}
 }
 
+void FPSciApp::pushRdStateWithLatency(RenderDevice* rd, float latencyMs) {
+	// When the latency changes, size the ring from the measured (smoothed) frame time (plus the current frame and one frame of margin)
+	// After that it grows/shrinks on demand (see popRdStateWithLatency)
+	if (latencyMs != m_delayRingLatencyMs || m_ldrDelayRing.capacity() == 0) {
+		const float smoothFrameRate = rd->stats().smoothFrameRate > 0.0f ? rd->stats().smoothFrameRate : float(max(window()->settings().refreshRate, 1));
+		m_ldrDelayRing.setCapacity(iCeil(0.001f * latencyMs * smoothFrameRate) + 2);
+		m_delayRingLatencyMs = latencyMs;
+	}
+	// Limit the memory held by the ring (RGB8 buffers, assuming 4 bytes/pixel as stored on the GPU)
+	const size_t frameBytes = size_t(rd->width()) * size_t(rd->height()) * 4;
+	const int maxBuffers = max(2, int(MAX_DELAY_BUFFER_BYTES / max(frameBytes, size_t(1))));
+	m_ldrDelayRing.setCapacity(min(m_ldrDelayRing.capacity(), maxBuffers));
+
+	// Render directly into the (timestamped) ring slot for this frame
+	rd->pushState(beginDelayedFrame(rd));
+}
+
+void FPSciApp::popRdStateWithLatency(RenderDevice* rd, float latencyMs) {
+	rd->popState();
+
+	// Present the newest frame captured at least latencyMs ago (or the oldest frame we have)
+	const RealTime now = m_ldrDelayRing.time(m_ldrDelayRing.size() - 1);
+	m_currentDelayBufferIndex = m_ldrDelayRing.newestBefore(now - 0.001 * latencyMs);
+	m_lastAddedLatency = float(now - m_ldrDelayRing.time(m_currentDelayBufferIndex));
+
+	// Render into the frame buffer or the composite shader input buffer (if provided)
+	rd->push2D(); {
+		Draw::rect2D(rd->viewport(), rd, Color3::white(), m_ldrDelayRing.at(m_currentDelayBufferIndex)->texture(0), Sampler::buffer());
+	} rd->pop2D();
+
+	// Grow the ring (capped in pushRdStateWithLatency) when even the oldest frame is too recent, and shrink it when more than 2 frames older than needed are held
+	if (m_currentDelayBufferIndex == 0 && m_lastAddedLatency < 0.001f * latencyMs && m_ldrDelayRing.size() == m_ldrDelayRing.capacity()) {
+		m_ldrDelayRing.setCapacity(m_ldrDelayRing.capacity() + 1);
+	}
+	else if (m_currentDelayBufferIndex > 2) {
+		m_ldrDelayRing.setCapacity(m_ldrDelayRing.capacity() - 1);
+	}
+}
+
 void FPSciApp::draw2DElements(RenderDevice* rd, Vector2 resolution) {
 	// Put elements that should not be delayed here
 	const float scale = resolution.x / 1920.0f;		// Double check on how this scale is used (seems to assume 1920x1080 defaults)	
@@ -278,7 +328,7 @@ void FPSciApp::draw2DElements(RenderDevice* rd, Vector2 resolution) {
 	}
 
 	// Click-to-photon mouse event indicator
-	if (trialConfig->clickToPhoton.enabled && trialConfig->clickToPhoton.mode != "total") {
+	if (trialConfig->clickToPhoton.enabled && trialConfig->clickToPhoton.mode != ClickToPhotonConfig::Mode::Total) {
 		drawClickIndicator(rd, trialConfig->clickToPhoton.mode, resolution);
 	}
 
@@ -319,8 +369,8 @@ void FPSciApp::drawDelayed2DElements(RenderDevice* rd, Vector2 resolution) {
 		m_combatTextList.removeNulls();
 	}
 
-	if (trialConfig->clickToPhoton.enabled && trialConfig->clickToPhoton.mode == "total") {
-		drawClickIndicator(rd, "total", resolution);
+	if (trialConfig->clickToPhoton.enabled && trialConfig->clickToPhoton.mode == ClickToPhotonConfig::Mode::Total) {
+		drawClickIndicator(rd, ClickToPhotonConfig::Mode::Total, resolution);
 	}
 
 	// Draw the HUD here
@@ -333,22 +383,22 @@ void FPSciApp::drawDelayed2DElements(RenderDevice* rd, Vector2 resolution) {
 	}
 }
 
-void FPSciApp::drawClickIndicator(RenderDevice* rd, String mode, Vector2 resolution) {
+void FPSciApp::drawClickIndicator(RenderDevice* rd, ClickToPhotonConfig::Mode mode, Vector2 resolution) {
 	// Click to photon latency measuring corner box
 	if (trialConfig->clickToPhoton.enabled) {
 		float boxLeft = 0.0f;
 		// Paint both sides by the width of latency measuring box.
 		Point2 latencyRect = trialConfig->clickToPhoton.size * resolution;
 		float boxTop = resolution.y * trialConfig->clickToPhoton.vertPos - latencyRect.y / 2;
-		if (trialConfig->clickToPhoton.mode == "both") {
-			boxTop = (mode == "minimum") ? boxTop - latencyRect.y : boxTop + latencyRect.y;
+		if (trialConfig->clickToPhoton.mode == ClickToPhotonConfig::Mode::Both) {
+			boxTop = (mode == ClickToPhotonConfig::Mode::Minimum) ? boxTop - latencyRect.y : boxTop + latencyRect.y;
 		}
-		if (trialConfig->clickToPhoton.side == "right") {
+		if (trialConfig->clickToPhoton.side == ClickToPhotonConfig::Side::Right) {
 			boxLeft = resolution.x - latencyRect.x;
 		}
 		// Draw the "active" box
 		Color3 boxColor;
-		if (trialConfig->clickToPhoton.mode == "frameRate") {
+		if (trialConfig->clickToPhoton.mode == ClickToPhotonConfig::Mode::FrameRate) {
 			boxColor = (frameToggle) ? trialConfig->clickToPhoton.colors[0] : trialConfig->clickToPhoton.colors[1];
 			frameToggle = !frameToggle;
 		}
@@ -368,59 +418,87 @@ void FPSciApp::drawFeedbackMessage(RenderDevice* rd) {
 		const float centerHeight = rd->height() * 0.4f;
 		const float scaledFontSize = floor(trialConfig->feedback.fontSize * scale);
 		if (!message.empty()) {
-			String currLine;
-			Array<String> lines = stringSplit(message, '\n');
-			float vertPos = centerHeight - (scaledFontSize * 1.5f * lines.length() / 2.0f);
+			// Only count lines when the message changes
+			if (message != m_feedbackMessage) {
+				m_feedbackMessage = message;
+				m_feedbackLineCount = stringSplit(message, '\n').length();
+			}
+			const float vertPos = centerHeight - (scaledFontSize * 1.5f * m_feedbackLineCount / 2.0f);
 			// Draw a "back plate"
 			Draw::rect2D(Rect2D::xywh(0.0f,
 				vertPos - 1.5f * scaledFontSize,
 				(float) rd->width(),
-				scaledFontSize * (lines.length() + 1) * 1.5f),
+				scaledFontSize * (m_feedbackLineCount + 1) * 1.5f),
 				rd, trialConfig->feedback.backgroundColor);
-			for (String line : lines) {
-				outputFont->draw2D(rd, line.c_str(),
-					(Point2(rd->width() * 0.5f, vertPos)).floor(),
-					scaledFontSize,
-					trialConfig->feedback.color,
-					trialConfig->feedback.outlineColor,
-					GFont::XALIGN_CENTER, GFont::YALIGN_CENTER
-				);
-				vertPos += scaledFontSize * 1.5f;
-			}
+			// Draw the (cached) lines of the message
+			m_textLayouts.draw(rd, "feedback", outputFont, message,
+				(Point2(rd->width() * 0.5f, vertPos)).floor(),
+				scaledFontSize,
+				trialConfig->feedback.color,
+				trialConfig->feedback.outlineColor,
+				GFont::XALIGN_CENTER, GFont::YALIGN_CENTER,
+				scaledFontSize * 1.5f
+			);
 		}
 	} rd->pop2D();
 }
 
 void FPSciApp::updateFPSIndicator(RenderDevice* rd, Vector2 resolution) {
-	// Track the instantaneous frame duration (no smoothing) in a circular queue (regardless of whether we are drawing the indicator)
-	if (m_frameDurationQueue.length() > MAX_HISTORY_TIMING_FRAMES) {
-		m_frameDurationQueue.dequeue();
-	}
-
+	// Track the instantaneous frame duration (no smoothing) in a sliding window (regardless of whether we are drawing the indicator)
 	const float f = rd->stats().frameRate;
 	const float t = 1.0f / f;
-	m_frameDurationQueue.enqueue(t);
+	m_frameDurations.add(t);
 
-	float recentMin = finf();
-	float recentMax = -finf();
-	for (int i = 0; i < m_frameDurationQueue.length(); ++i) {
-		const float t = m_frameDurationQueue[i];
-		recentMin = min(recentMin, t);
-		recentMax = max(recentMax, t);
-	}
+	const float recentMin = m_frameDurations.minimum();
+	const float recentMax = m_frameDurations.maximum();
 
 	if (renderFPS) {
-		// Draw the FPS indicator
-		const float scale = resolution.x / 1920.0f;
-		String msg;
-		if (window()->settings().refreshRate > 0) {
-			msg = format("%d measured | %d requested fps", iRound(rd->stats().smoothFrameRate), window()->settings().refreshRate);
+		// Update the statistics text at a fixed rate (so it is readable, and its layouts aren't rebuilt every frame)
+		const RealTime now = System::time();
+		const bool showClickToPhoton = notNull(m_eventLogger) && m_eventLogger->running();
+		if (now - m_lastStatsTextTime >= STATS_TEXT_PERIOD_S) {
+			m_lastStatsTextTime = now;
+			if (window()->settings().refreshRate > 0) {
+				m_fpsText = format("%d measured | %d requested fps", iRound(rd->stats().smoothFrameRate), window()->settings().refreshRate);
+			}
+			else {
+				m_fpsText = format("%d fps", iRound(rd->stats().smoothFrameRate));
+			}
+			m_fpsText += format(" | %.1f min | %.1f avg | %.1f max ms", recentMin * 1000.0f, 1000.0f / rd->stats().smoothFrameRate, 1000.0f * recentMax);
+
+			// Frame pacing error statistics (for this session)
+			m_pacingText = format("%s pacing error | %.2f mean | %.2f p99 | %.2f max ms", RenderConfig::framePacingNames()[int(trialConfig->render.framePacing)].c_str(),
+				1000.0f * m_pacingErrors.mean(), 1000.0f * m_pacingErrors.percentile(0.99f), 1000.0f * m_pacingErrors.maximum());
+
+			// Click-to-photon latency statistics (for this trial and frame rate condition)
+			if (showClickToPhoton) {
+				const LatencySketch trial = m_eventLogger->stats().trial();
+				const LatencySketch condition = m_eventLogger->stats().currentCondition();
+				m_clickToPhotonText = format("Click-to-photon trial (%d) | %.1f p50 | %.1f p95 | %.1f p99 ms", trial.count(), trial.quantile(0.5f), trial.quantile(0.95f), trial.quantile(0.99f));
+				m_clickToPhotonText += format("\n%s (%d) | %.1f p50 | %.1f p95 | %.1f p99 ms", m_eventLogger->stats().condition().c_str(), condition.count(),
+					condition.quantile(0.5f), condition.quantile(0.95f), condition.quantile(0.99f));
+			}
+
+			// Most recent time for each render pass
+			m_passTimesText = m_passTimer.gpuTiming() ? "GPU pass times (ms)" : "CPU pass times (ms)";
+			for (const String& pass : m_passTimer.passNames()) {
+				m_passTimesText += format("\n%s: %.2f", pass.c_str(), 1000.0f * m_passTimer.lastTime(pass));
+			}
 		}
-		else {
-			msg = format("%d fps", iRound(rd->stats().smoothFrameRate));
+
+		// Draw the FPS indicator, with the pacing (and latency) statistics and pass times below it
+		const float scale = resolution.x / 1920.0f;
+		m_textLayouts.draw(rd, "fps", outputFont, m_fpsText, Point2(0.75f * resolution.x, 0.05f * resolution.y).floor(), floor(20.0f * scale), Color3::yellow());
+		m_textLayouts.draw(rd, "pacing", outputFont, m_pacingText, Point2(0.75f * resolution.x, 0.05f * resolution.y + 25.0f * scale).floor(), floor(20.0f * scale), Color3::yellow());
+
+		float nextLine = 50.0f;
+		if (showClickToPhoton) {
+			m_textLayouts.draw(rd, "clickToPhoton", outputFont, m_clickToPhotonText, Point2(0.75f * resolution.x, 0.05f * resolution.y + nextLine * scale).floor(), floor(20.0f * scale), Color3::yellow(),
+				Color4::clear(), GFont::XALIGN_LEFT, GFont::YALIGN_TOP, 25.0f * scale);
+			nextLine += 50.0f;
 		}
-		msg += format(" | %.1f min | %.1f avg | %.1f max ms", recentMin * 1000.0f, 1000.0f / rd->stats().smoothFrameRate, 1000.0f * recentMax);
-		outputFont->draw2D(rd, msg, Point2(0.75f * resolution.x, 0.05f * resolution.y).floor(), floor(20.0f * scale), Color3::yellow());
+		m_textLayouts.draw(rd, "passTimes", outputFont, m_passTimesText, Point2(0.75f * resolution.x, 0.05f * resolution.y + nextLine * scale).floor(), floor(20.0f * scale), Color3::yellow(),
+			Color4::clear(), GFont::XALIGN_LEFT, GFont::YALIGN_TOP, 25.0f * scale);
 	}
 }
 
@@ -430,43 +508,38 @@ void FPSciApp::drawHUD(RenderDevice *rd, Vector2 resolution) {
 
 	RealTime now = m_lastOnSimulationRealTime;
 
+	// Solid HUD geometry (cooldown indicator and health bar) is batched into a single draw
+	m_hudBatch.clear();
+
 	// Weapon ready status (cooldown indicator)
 	if (trialConfig->hud.renderWeaponStatus) {
 		// Draw the "active" cooldown box
-		if (trialConfig->hud.cooldownMode == "box") {
+		switch (trialConfig->hud.cooldownMode) {
+		case HudConfig::CooldownMode::Box: {
 			float boxLeft = 0.0f;
-			if (trialConfig->hud.weaponStatusSide == "right") {
+			if (trialConfig->hud.weaponStatusSide == HudConfig::Side::Right) {
 				// swap side
 				boxLeft = resolution.x * (1.0f - trialConfig->clickToPhoton.size.x);
 			}
-			Draw::rect2D(
+			m_hudBatch.addRect(
 				Rect2D::xywh(
 					boxLeft,
 					resolution.y * (weapon->cooldownRatio(now)),
 					resolution.x * trialConfig->clickToPhoton.size.x,
 					resolution.y * (1.0f - weapon->cooldownRatio(now))
-				), rd, Color3::white() * 0.8f
+				), Color3::white() * 0.8f
 			);
+			break;
 		}
-		else if (trialConfig->hud.cooldownMode == "ring") {
-			// Draw cooldown "ring" instead of box
+		case HudConfig::CooldownMode::Ring: {
+			// Draw cooldown "ring" instead of box (ring geometry is cached per subdivision count)
 			const float iRad = trialConfig->hud.cooldownInnerRadius;
 			const float oRad = iRad + trialConfig->hud.cooldownThickness;
 			const int segments = trialConfig->hud.cooldownSubdivisions;
 			int segsToLight = static_cast<int>(ceilf((1 - weapon->cooldownRatio(now))*segments));
-			// Create the segments
-			for (int i = 0; i < segsToLight; i++) {
-				const float inc = static_cast<float>(2 * pi() / segments);
-				const float theta = -i * inc;
-				Vector2 center = resolution / 2.0f;
-				Array<Vector2> verts = {
-					center + Vector2(oRad*sin(theta), -oRad * cos(theta)),
-					center + Vector2(oRad*sin(theta + inc), -oRad * cos(theta + inc)),
-					center + Vector2(iRad*sin(theta + inc), -iRad * cos(theta + inc)),
-					center + Vector2(iRad*sin(theta), -iRad * cos(theta))
-				};
-				Draw::poly2D(verts, rd, trialConfig->hud.cooldownColor);
-			}
+			m_hudBatch.addRing(resolution / 2.0f, iRad, oRad, segments, segsToLight, trialConfig->hud.cooldownColor);
+			break;
+		}
 		}
 	}
 
@@ -481,14 +554,16 @@ void FPSciApp::drawHUD(RenderDevice *rd, Vector2 resolution) {
 		const Color4 borderColor = trialConfig->hud.playerHealthBarBorderColor;
 		const Color4 color = trialConfig->hud.playerHealthBarColors[1] * (1.0f - health) + trialConfig->hud.playerHealthBarColors[0] * health;
 
-		Draw::rect2D(Rect2D::xywh(location - border, size + border + border), rd, borderColor);
-		Draw::rect2D(Rect2D::xywh(location, size*Point2(health, 1.0f)), rd, color);
+		m_hudBatch.addRect(Rect2D::xywh(location - border, size + border + border), borderColor);
+		m_hudBatch.addRect(Rect2D::xywh(location, size*Point2(health, 1.0f)), color);
 	}
+	m_hudBatch.draw(rd);
+
 	// Draw the ammo indicator
 	if (trialConfig->hud.showAmmo) {
 		//const float guardband = (rd->framebuffer()->width() - window()->framebuffer()->width()) / 2.0f;
 		Point2 lowerRight = resolution; //Point2(static_cast<float>(rd->viewport().width()), static_cast<float>(rd->viewport().height())) - Point2(guardband, guardband);
-		hudFont->draw2D(rd,
+		m_textLayouts.draw(rd, "ammo", hudFont,
 			format("%d/%d", weapon->remainingAmmo(), trialConfig->weapon.maxAmmo),
 			lowerRight - trialConfig->hud.ammoPosition,
 			trialConfig->hud.ammoSize,
@@ -505,13 +580,16 @@ void FPSciApp::drawHUD(RenderDevice *rd, Vector2 resolution) {
 		Draw::rect2D((scoreBannerTexture->rect2DBounds() * scale - scoreBannerTexture->vector2Bounds() * scale / 2.0f) * 0.8f + hudCenter, rd, Color3::white(), scoreBannerTexture);
 
 		// Create strings for time remaining, progress in sessions, and score
-		float time;
-		if (trialConfig->hud.bannerTimerMode == "remaining") {
-			time = sess->getRemainingTrialTime();
-			if (time < 0.f) time = 0.f;
-		}
-		else if (trialConfig->hud.bannerTimerMode == "elapsed") {
+		float time = 0.f;
+		switch (trialConfig->hud.bannerTimerMode) {
+		case HudConfig::BannerTimerMode::Remaining:
+			time = max(sess->getRemainingTrialTime(), 0.f);
+			break;
+		case HudConfig::BannerTimerMode::Elapsed:
 			time = sess->getElapsedTrialTime();
+			break;
+		case HudConfig::BannerTimerMode::None:
+			break;
 		}
 		String time_string = time < 10000.f ? format("%0.1f", time) : "---";		// Only allow up to 3 digit time strings
 
@@ -536,18 +614,19 @@ void FPSciApp::drawHUD(RenderDevice *rd, Vector2 resolution) {
 			score_string = format("%dB", (int)G3D::round(score / 1e9));
 		}
 
-		if (trialConfig->hud.bannerTimerMode != "none" && sess->inTask()) {
-			hudFont->draw2D(rd, time_string, hudCenter - Vector2(80, 0) * scale.x, scale.x * trialConfig->hud.bannerSmallFontSize,
+		if (trialConfig->hud.bannerTimerMode != HudConfig::BannerTimerMode::None && sess->inTask()) {
+			m_textLayouts.draw(rd, "bannerTime", hudFont, time_string, hudCenter - Vector2(80, 0) * scale.x, scale.x * trialConfig->hud.bannerSmallFontSize,
 				Color3::white(), Color4::clear(), GFont::XALIGN_RIGHT, GFont::YALIGN_CENTER);
 		}
-		if(trialConfig->hud.bannerShowProgress) hudFont->draw2D(rd, prog_string, hudCenter + Vector2(0, -1), scale.x * trialConfig->hud.bannerLargeFontSize, Color3::white(), Color4::clear(), GFont::XALIGN_CENTER, GFont::YALIGN_CENTER);
-		if(trialConfig->hud.bannerShowScore) hudFont->draw2D(rd, score_string, hudCenter + Vector2(125, 0) * scale, scale.x * trialConfig->hud.bannerSmallFontSize, Color3::white(), Color4::clear(), GFont::XALIGN_RIGHT, GFont::YALIGN_CENTER);
+		if(trialConfig->hud.bannerShowProgress) m_textLayouts.draw(rd, "bannerProgress", hudFont, prog_string, hudCenter + Vector2(0, -1), scale.x * trialConfig->hud.bannerLargeFontSize, Color3::white(), Color4::clear(), GFont::XALIGN_CENTER, GFont::YALIGN_CENTER);
+		if(trialConfig->hud.bannerShowScore) m_textLayouts.draw(rd, "bannerScore", hudFont, score_string, hudCenter + Vector2(125, 0) * scale, scale.x * trialConfig->hud.bannerSmallFontSize, Color3::white(), Color4::clear(), GFont::XALIGN_RIGHT, GFont::YALIGN_CENTER);
 	}
 
 	// Draw any static HUD elements
-	for (StaticHudElement element : trialConfig->hud.staticElements) {
-		if (!hudTextures.containsKey(element.filename)) continue;						// Skip any items we haven't loaded
-		const shared_ptr<Texture> texture = hudTextures[element.filename];				// Get the loaded texture for this element
+	for (const StaticHudElement& element : trialConfig->hud.staticElements) {
+		const shared_ptr<Texture>* loaded = hudTextures.getPointer(element.filename);
+		if (isNull(loaded)) continue;													// Skip any items we haven't loaded
+		const shared_ptr<Texture>& texture = *loaded;									// Get the loaded texture for this element
 		const Vector2 size = element.scale * scale * texture->vector2Bounds();			// Get the final size of the image
 		const Vector2 pos = (element.position * resolution) - size/2.0;					// Compute position (center image on provided position)
 		Draw::rect2D(Rect2D::xywh(pos, size), rd, Color3::white(), texture);			// Draw the rect
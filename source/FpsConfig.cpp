@@ -1,7 +1,9 @@
 #include "FpsConfig.h"
+#include <mutex>
 
 template <class T>
 static bool operator!=(Array<T> a1, Array<T> a2) {
+	if (a1.size() != a2.size()) return true;
 	for (int i = 0; i < a1.size(); i++) {
 		if (a1[i] != a2[i]) return true;
 	}
@@ -91,27 +93,34 @@ bool SceneConfig::operator!=(const SceneConfig& other) const {
 }
 
 void RenderConfig::load(FPSciAnyTableReader reader, int settingsVersion) {
-	// List of valid frame time modes for parsing from Any
-	const Array<String> validFrameTimeModes = { "always", "taskonly", "restartwithtask" };
-
 	switch (settingsVersion) {
 	case 1:
 		reader.getIfPresent("frameRate", frameRate);
 		reader.getIfPresent("frameDelay", frameDelay);
+		reader.getIfPresent("frameDelayMs", frameDelayMs);
+		if (frameDelayMs < 0.0f) {
+			throw format("Specified \"frameDelayMs\" (%f) must be >= 0!", frameDelayMs);
+		}
 		reader.getIfPresent("frameTimeArray", frameTimeArray);
 		reader.getIfPresent("frameTimeRandomize", frameTimeRandomize);
 		
-		reader.getIfPresent("frameTimeMode", frameTimeMode);
-		frameTimeMode = toLower(frameTimeMode);	// Convert to lower case
-		if (!validFrameTimeModes.contains(frameTimeMode)) {
-			String errMsg = "Specified \"frameTimeMode\" (\"" + frameTimeMode + "\") is invalid, must be one of: [";
-			for (int i = 0; i < validFrameTimeModes.length(); i++) {
-				errMsg += "\"" + validFrameTimeModes[i] + "\", ";
+		reader.getEnumIfPresent("frameTimeMode", frameTimeMode, frameTimeModeNames());
+
+		reader.getIfPresent("frameTimeProfiles", frameTimeProfiles);
+		reader.getIfPresent("frameTimeProfile", frameTimeProfile);
+		if (!frameTimeProfile.empty()) {
+			bool found = false;
+			for (const FrameTimeProfileConfig& profile : frameTimeProfiles) {
+				found = found || profile.name == frameTimeProfile;
+			}
+			if (!found) {
+				throw format("Specified \"frameTimeProfile\" (\"%s\") must be the name of one of the \"frameTimeProfiles\"!", frameTimeProfile.c_str());
 			}
-			errMsg = errMsg.substr(0, errMsg.length() - 2) + "]!";
-			throw errMsg;
 		}
 
+		reader.getEnumIfPresent("framePacing", framePacing, framePacingNames());
+		reader.getIfPresent("framePacingSpinMs", framePacingSpinMs);
+
 		reader.getIfPresent("horizontalFieldOfView", hFoV);
 
 		reader.getIfPresent("resolution2D", resolution2D);
@@ -130,6 +139,20 @@ void RenderConfig::load(FPSciAnyTableReader reader, int settingsVersion) {
 		reader.getIfPresent("samplerComposite", samplerComposite);
 		reader.getIfPresent("samplerFinal", samplerFinal);
 
+		reader.getIfPresent("shaderPasses", shaderPasses);
+		// Check that all named inputs refer to an earlier pass in the same stage
+		for (int i = 0; i < shaderPasses.size(); i++) {
+			if (shaderPasses[i].input.empty()) continue;
+			bool found = false;
+			for (int j = 0; j < i; j++) {
+				found = found || (shaderPasses[j].name == shaderPasses[i].input && shaderPasses[j].stage == shaderPasses[i].stage);
+			}
+			if (!found) {
+				throw format("Shader pass \"%s\" input (\"%s\") must be the name of an earlier pass in the \"%s\" stage!",
+					shaderPasses[i].name.c_str(), shaderPasses[i].input.c_str(), shaderPasses[i].stage.c_str());
+			}
+		}
+
 		break;
 	default:
 		throw format("Did not recognize settings version: %d", settingsVersion);
@@ -149,9 +172,14 @@ Any RenderConfig::addToAny(Any a, bool forceAll) const {
 	RenderConfig def;
 	if (forceAll || def.frameRate != frameRate)					a["frameRate"] = frameRate;
 	if (forceAll || def.frameDelay != frameDelay)				a["frameDelay"] = frameDelay;
+	if (forceAll || def.frameDelayMs != frameDelayMs)			a["frameDelayMs"] = frameDelayMs;
 	if (forceAll || def.frameTimeArray != frameTimeArray)		a["frameTimeArray"] = frameTimeArray;
 	if (forceAll || def.frameTimeRandomize != frameTimeRandomize) a["frameTimeRandomize"] = frameTimeRandomize;
-	if (forceAll || def.frameTimeMode != frameTimeMode)			a["frameTimeMode"] = frameTimeMode;
+	if (forceAll || def.frameTimeMode != frameTimeMode)			a["frameTimeMode"] = frameTimeModeNames()[int(frameTimeMode)];
+	if (forceAll || def.frameTimeProfiles != frameTimeProfiles)	a["frameTimeProfiles"] = frameTimeProfiles;
+	if (forceAll || def.frameTimeProfile != frameTimeProfile)	a["frameTimeProfile"] = frameTimeProfile;
+	if (forceAll || def.framePacing != framePacing)				a["framePacing"] = framePacingNames()[int(framePacing)];
+	if (forceAll || def.framePacingSpinMs != framePacingSpinMs)	a["framePacingSpinMs"] = framePacingSpinMs;
 	if (forceAll || def.hFoV != hFoV)							a["horizontalFieldOfView"] = hFoV;
 
 	if (forceAll || def.resolution2D != resolution2D)			a["resolution2D"] = resolution2D;
@@ -169,10 +197,193 @@ Any RenderConfig::addToAny(Any a, bool forceAll) const {
 	if (forceAll || def.samplerPrecomposite != samplerPrecomposite)	a["samplerPrecomposite"] = samplerPrecomposite;
 	if (forceAll || def.samplerComposite != samplerComposite)	a["samplerComposite"] = samplerComposite;
 	if (forceAll || def.samplerFinal != samplerFinal)			a["samplerFinal"] = samplerFinal;
+
+	if (forceAll || def.shaderPasses != shaderPasses)			a["shaderPasses"] = shaderPasses;
 	
 	return a;
 }
 
+Array<ShaderPassConfig> RenderConfig::stagePasses(const String& stage) const {
+	Array<ShaderPassConfig> passes;
+	if (shaderPasses.size() > 0) {
+		for (const ShaderPassConfig& pass : shaderPasses) {
+			if (pass.stage == stage) passes.append(pass);
+		}
+		return passes;
+	}
+
+	// Build the equivalent (single) pass from the individual shader settings
+	ShaderPassConfig pass;
+	pass.stage = stage;
+	if (stage == "3D" && (!shader3D.empty() || resolution3D[0] > 0)) {
+		pass.name = "shader3D";
+		pass.shader = shader3D;
+		pass.resolution = resolution3D;
+		pass.sampler = sampler3D;
+		passes.append(pass);
+	}
+	else if (stage == "2D" && !shader2D.empty()) {
+		pass.name = "shader2D";
+		pass.shader = shader2D;
+		pass.sampler = sampler2D;
+		passes.append(pass);
+	}
+	else if (stage == "composite" && !shaderComposite.empty()) {
+		pass.name = "shaderComposite";
+		pass.shader = shaderComposite;
+		pass.sampler = samplerComposite;
+		passes.append(pass);
+	}
+	return passes;
+}
+
+ShaderPassConfig::ShaderPassConfig(const Any& any) {
+	// List of valid stages for a shader pass
+	const Array<String> validStages = { "3d", "2d", "composite" };
+
+	FPSciAnyTableReader reader(any);
+	reader.get("name", name, "Must provide a name for all shader passes!");
+	reader.getIfPresent("stage", stage);
+	// Use the (case sensitive) stage names from here on
+	if (!validStages.contains(toLower(stage))) {
+		throw format("Shader pass \"%s\" stage (\"%s\") is invalid, must be one of: [\"3D\", \"2D\", \"composite\"]!", name.c_str(), stage.c_str());
+	}
+	stage = toLower(stage) == "composite" ? "composite" : toUpper(stage);
+	reader.getIfPresent("shader", shader);
+	reader.getIfPresent("input", input);
+	reader.getIfPresent("resolution", resolution);
+	reader.getIfPresent("sampler", sampler);
+}
+
+Any ShaderPassConfig::toAny(const bool forceAll) const {
+	ShaderPassConfig def;
+	Any a(Any::TABLE);
+	a["name"] = name;
+	if (forceAll || def.stage != stage)					a["stage"] = stage;
+	if (forceAll || def.shader != shader)				a["shader"] = shader;
+	if (forceAll || def.input != input)					a["input"] = input;
+	if (forceAll || def.resolution != resolution)		a["resolution"] = resolution;
+	if (forceAll || def.sampler != sampler)				a["sampler"] = sampler;
+	return a;
+}
+
+bool ShaderPassConfig::operator!=(const ShaderPassConfig& other) const {
+	return name != other.name ||
+		stage != other.stage ||
+		shader != other.shader ||
+		input != other.input ||
+		resolution != other.resolution ||
+		sampler != other.sampler;
+}
+
+FrameTimeProfileConfig::FrameTimeProfileConfig(const Any& any) {
+	FPSciAnyTableReader reader(any);
+	reader.get("name", name, "Must provide a name for all frame time profiles!");
+	reader.getEnumIfPresent("type", type, typeNames());
+	reader.getIfPresent("times", times);
+	reader.getIfPresent("frameTimes", frameTimes);
+	reader.getIfPresent("traceFile", traceFile);
+	reader.getIfPresent("traceColumn", traceColumn);
+	reader.getIfPresent("stutterPeriod", stutterPeriod);
+	reader.getIfPresent("stutterAmplitude", stutterAmplitude);
+	reader.getEnumIfPresent("stutterDistribution", stutterDistribution, distributionNames());
+	reader.getIfPresent("duration", duration);
+	reader.getIfPresent("loop", loop);
+
+	// Load the trace (once, here) so that compiling the profile at the start of a trial doesn't touch the disk
+	if (type == Type::Trace && !traceFile.empty()) {
+		static std::mutex fileMutex;		// Sessions are parsed in parallel, serialize the (cached) data file lookup
+		String text;
+		{
+			std::lock_guard<std::mutex> lock(fileMutex);
+			text = readWholeFile(System::findDataFile(traceFile));
+		}
+		trace = parseTrace(text, traceColumn);
+	}
+
+	// Validate the profile
+	if (type == Type::Step || type == Type::Ramp) {
+		if (times.size() == 0 || times.size() != frameTimes.size()) {
+			throw format("Frame time profile \"%s\" must provide \"times\" and \"frameTimes\" arrays of the same (non-zero) length!", name.c_str());
+		}
+		for (int i = 1; i < times.size(); i++) {
+			if (times[i] < times[i - 1]) throw format("Frame time profile \"%s\" \"times\" must be in increasing order!", name.c_str());
+		}
+	}
+	else if (type == Type::Stutter && stutterPeriod <= 0.0f) {
+		throw format("Frame time profile \"%s\" must provide a \"stutterPeriod\" > 0!", name.c_str());
+	}
+	else if (type == Type::Trace && frameTimes.size() == 0 && trace.size() == 0) {
+		throw format("Frame time profile \"%s\" must provide either \"frameTimes\" or a (non-empty) \"traceFile\"!", name.c_str());
+	}
+	for (float frameTime : (trace.size() > 0 ? trace : frameTimes)) {
+		if (frameTime <= 0.0f) throw format("Frame time profile \"%s\" frame times must all be > 0!", name.c_str());
+	}
+	if (stutterAmplitude < 0.0f) {
+		throw format("Frame time profile \"%s\" \"stutterAmplitude\" must be >= 0!", name.c_str());
+	}
+}
+
+Any FrameTimeProfileConfig::toAny(const bool forceAll) const {
+	FrameTimeProfileConfig def;
+	Any a(Any::TABLE);
+	a["name"] = name;
+	if (forceAll || def.type != type)									a["type"] = typeNames()[int(type)];
+	if (forceAll || def.times != times)									a["times"] = times;
+	if (forceAll || def.frameTimes != frameTimes)						a["frameTimes"] = frameTimes;
+	if (forceAll || def.traceFile != traceFile)							a["traceFile"] = traceFile;
+	if (forceAll || def.traceColumn != traceColumn)						a["traceColumn"] = traceColumn;
+	if (forceAll || def.stutterPeriod != stutterPeriod)					a["stutterPeriod"] = stutterPeriod;
+	if (forceAll || def.stutterAmplitude != stutterAmplitude)			a["stutterAmplitude"] = stutterAmplitude;
+	if (forceAll || def.stutterDistribution != stutterDistribution)		a["stutterDistribution"] = distributionNames()[int(stutterDistribution)];
+	if (forceAll || def.duration != duration)							a["duration"] = duration;
+	if (forceAll || def.loop != loop)									a["loop"] = loop;
+	return a;
+}
+
+bool FrameTimeProfileConfig::operator!=(const FrameTimeProfileConfig& other) const {
+	return name != other.name ||
+		type != other.type ||
+		times != other.times ||
+		frameTimes != other.frameTimes ||
+		traceFile != other.traceFile ||
+		traceColumn != other.traceColumn ||
+		stutterPeriod != other.stutterPeriod ||
+		stutterAmplitude != other.stutterAmplitude ||
+		stutterDistribution != other.stutterDistribution ||
+		duration != other.duration ||
+		loop != other.loop;
+}
+
+Array<float> FrameTimeProfileConfig::parseTrace(const String& text, const String& column) {
+	Array<float> frameTimes;
+	int colIdx = 0;
+	bool firstLine = true;
+	for (String line : stringSplit(text, '\n')) {
+		line = trimWhitespace(line);
+		if (line.empty()) continue;
+		const Array<String> fields = stringSplit(line, ',');
+		if (firstLine) {
+			firstLine = false;
+			// A non-numeric first line is a (CSV) header, find the requested column in it
+			char* end;
+			const String first = trimWhitespace(fields[0]);
+			strtod(first.c_str(), &end);
+			if (first.empty() || *end != '\0') {
+				colIdx = -1;
+				for (int i = 0; i < fields.size(); i++) {
+					if (trimWhitespace(fields[i]) == column) colIdx = i;
+				}
+				if (colIdx < 0) throw format("Could not find the \"%s\" column in the frame time trace!", column.c_str());
+				continue;
+			}
+		}
+		if (colIdx >= fields.size()) continue;
+		frameTimes.append(0.001f * float(atof(fields[colIdx].c_str())));		// Convert from ms to s
+	}
+	return frameTimes;
+}
+
 void PlayerConfig::load(FPSciAnyTableReader reader, int settingsVersion) {
 	switch (settingsVersion) {
 	case 1:
@@ -238,18 +449,7 @@ void HudConfig::load(FPSciAnyTableReader reader, int settingsVersion) {
 	case 1:
 		reader.getIfPresent("showHUD", enable);
 		reader.getIfPresent("showBanner", showBanner);
-		if (reader.getIfPresent("bannerTimerMode", bannerTimerMode)) {
-			bannerTimerMode = toLower(bannerTimerMode);
-			const Array<String> validTimeModes = { "none", "elapsed", "remaining" };
-			if (!validTimeModes.contains(bannerTimerMode)) {
-				String errString = format("\"bannerShowTime\" value \"%s\" is invalid, must be specified as one of the valid modes (", bannerTimerMode);
-				for (String validTimeMode : validTimeModes) {
-					errString += "\"" + validTimeMode + "\", ";
-				}
-				errString = errString.substr(0, errString.length() - 2) + ")!";
-				throw errString.c_str();
-			}
-		}
+		reader.getEnumIfPresent("bannerTimerMode", bannerTimerMode, bannerTimerModeNames());
 		reader.getIfPresent("bannerShowProgress", bannerShowProgress);
 		reader.getIfPresent("bannerShowScore", bannerShowScore);
 		reader.getIfPresent("hudFont", hudFont);
@@ -265,8 +465,8 @@ void HudConfig::load(FPSciAnyTableReader reader, int settingsVersion) {
 		reader.getIfPresent("ammoColor", ammoColor);
 		reader.getIfPresent("ammoOutlineColor", ammoOutlineColor);
 		reader.getIfPresent("renderWeaponStatus", renderWeaponStatus);
-		reader.getIfPresent("weaponStatusSide", weaponStatusSide);
-		reader.getIfPresent("cooldownMode", cooldownMode);
+		reader.getEnumIfPresent("weaponStatusSide", weaponStatusSide, sideNames());
+		reader.getEnumIfPresent("cooldownMode", cooldownMode, cooldownModeNames());
 		reader.getIfPresent("cooldownInnerRadius", cooldownInnerRadius);
 		reader.getIfPresent("cooldownThickness", cooldownThickness);
 		reader.getIfPresent("cooldownSubdivisions", cooldownSubdivisions);
@@ -283,7 +483,7 @@ Any HudConfig::addToAny(Any a, bool forceAll) const {
 	HudConfig def;
 	if (forceAll || def.enable != enable)											a["showHUD"] = enable;
 	if (forceAll || def.showBanner != showBanner)									a["showBanner"] = showBanner;
-	if (forceAll || def.bannerTimerMode != bannerTimerMode)							a["bannerTimerMode"] = bannerTimerMode;
+	if (forceAll || def.bannerTimerMode != bannerTimerMode)							a["bannerTimerMode"] = bannerTimerModeNames()[int(bannerTimerMode)];
 	if (forceAll || def.bannerShowProgress != bannerShowProgress)					a["bannerShowProgress"] = bannerShowProgress;
 	if (forceAll || def.bannerShowScore != bannerShowScore)							a["bannerShowScore"] = bannerShowScore;
 	if (forceAll || def.hudFont != hudFont)											a["hudFont"] = hudFont;
@@ -299,8 +499,8 @@ Any HudConfig::addToAny(Any a, bool forceAll) const {
 	if (forceAll || def.ammoColor != ammoColor)										a["ammoColor"] = ammoColor;
 	if (forceAll || def.ammoOutlineColor != ammoOutlineColor)						a["ammoOutlineColor"] = ammoOutlineColor;
 	if (forceAll || def.renderWeaponStatus != renderWeaponStatus)					a["renderWeaponStatus"] = renderWeaponStatus;
-	if (forceAll || def.weaponStatusSide != weaponStatusSide)						a["weaponStatusSide"] = weaponStatusSide;
-	if (forceAll || def.cooldownMode != cooldownMode)								a["cooldownMode"] = cooldownMode;
+	if (forceAll || def.weaponStatusSide != weaponStatusSide)						a["weaponStatusSide"] = sideNames()[int(weaponStatusSide)];
+	if (forceAll || def.cooldownMode != cooldownMode)								a["cooldownMode"] = cooldownModeNames()[int(cooldownMode)];
 	if (forceAll || def.cooldownInnerRadius != cooldownInnerRadius)					a["cooldownInnerRadius"] = cooldownInnerRadius;
 	if (forceAll || def.cooldownThickness != cooldownThickness)						a["cooldownThickness"] = cooldownThickness;
 	if (forceAll || def.cooldownSubdivisions != cooldownSubdivisions)				a["cooldownSubdivisions"] = cooldownSubdivisions;
@@ -415,7 +615,7 @@ void FeedbackConfig::load(FPSciAnyTableReader reader, int settingsVersion) {
 		else if (!toLower(scoreModelStr).compare("accuracy")) scoreModel = ScoreType::Accuracy;
 		else if (!toLower(scoreModelStr).compare("trial successes")) scoreModel = ScoreType::TrialSuccesses;
 		reader.getIfPresent("scoreMultiplier", scoreMultiplier);
-
+		compileMessages();
 		break;
 	default:
 		throw format("Did not recognize settings version: %d", settingsVersion);
@@ -423,6 +623,44 @@ void FeedbackConfig::load(FPSciAnyTableReader reader, int settingsVersion) {
 	}
 }
 
+FeedbackConfig::FeedbackConfig() {
+	// The first default config compiles the default messages (its strings are still the defaults here), later configs share them
+	static const FeedbackConfig defaults = [this]() {
+		FeedbackConfig config(*this);
+		config.compileMessages();
+		return config;
+	}();
+	initialWithRefMsg = defaults.initialWithRefMsg;
+	initialNoRefMsg = defaults.initialNoRefMsg;
+	aimInvalidMsg = defaults.aimInvalidMsg;
+	trialSuccessMsg = defaults.trialSuccessMsg;
+	trialFailureMsg = defaults.trialFailureMsg;
+	taskSuccessMsg = defaults.taskSuccessMsg;
+	taskFailureMsg = defaults.taskFailureMsg;
+	blockCompleteMsg = defaults.blockCompleteMsg;
+	sessCompleteMsg = defaults.sessCompleteMsg;
+	allSessCompleteMsg = defaults.allSessCompleteMsg;
+}
+
+/** Compile a message if its string has changed (messages are shared by copies, so unchanged messages are kept) */
+static void compileMessage(MessageTemplate& msg, const String& source, const String& name) {
+	if (msg.source() == source) return;
+	msg = MessageTemplate(source, MessageTemplate::feedbackVars(), name);
+}
+
+void FeedbackConfig::compileMessages() {
+	compileMessage(initialWithRefMsg, initialWithRef, "referenceTargetInitialFeedback");
+	compileMessage(initialNoRefMsg, initialNoRef, "noReferenceTargetInitialFeedback");
+	compileMessage(aimInvalidMsg, aimInvalid, "pretrialAimInvalidFeedback");
+	compileMessage(trialSuccessMsg, trialSuccess, "trialSuccessFeedback");
+	compileMessage(trialFailureMsg, trialFailure, "trialFailureFeedback");
+	compileMessage(taskSuccessMsg, taskSuccess, "taskSuccessFeedback");
+	compileMessage(taskFailureMsg, taskFailure, "taskFailureFeedback");
+	compileMessage(blockCompleteMsg, blockComplete, "blockCompleteFeedback");
+	compileMessage(sessCompleteMsg, sessComplete, "sessionCompleteFeedback");
+	compileMessage(allSessCompleteMsg, allSessComplete, "allSessionsCompleteFeedback");
+}
+
 Any FeedbackConfig::addToAny(Any a, bool forceAll) const {
 	FeedbackConfig def;
 	if (forceAll || def.initialWithRef != initialWithRef)	a["referenceTargetInitialFeedback"] = initialWithRef;
@@ -527,8 +765,8 @@ void ClickToPhotonConfig::load(FPSciAnyTableReader reader, int settingsVersion)
 	switch (settingsVersion) {
 	case 1:
 		reader.getIfPresent("renderClickPhoton", enabled);
-		reader.getIfPresent("clickPhotonSide", side);
-		reader.getIfPresent("clickPhotonMode", mode);
+		reader.getEnumIfPresent("clickPhotonSide", side, sideNames());
+		reader.getEnumIfPresent("clickPhotonMode", mode, modeNames());
 		reader.getIfPresent("clickPhotonSize", size);
 		reader.getIfPresent("clickPhotonVertPos", vertPos);
 		reader.getIfPresent("clickPhotonColors", colors);
@@ -542,7 +780,8 @@ void ClickToPhotonConfig::load(FPSciAnyTableReader reader, int settingsVersion)
 Any ClickToPhotonConfig::addToAny(Any a, bool forceAll) const {
 	ClickToPhotonConfig def;
 	if (forceAll || def.enabled != enabled)		a["renderClickPhoton"] = enabled;
-	if (forceAll || def.side != side)			a["clickPhotonSide"] = side;
+	if (forceAll || def.side != side)			a["clickPhotonSide"] = sideNames()[int(side)];
+	if (forceAll || def.mode != mode)			a["clickPhotonMode"] = modeNames()[int(mode)];
 	if (forceAll || def.size != size)			a["clickPhotonSize"] = size;
 	if (forceAll || def.vertPos != vertPos)		a["clickPhotonVertPos"] = vertPos;
 	if (forceAll || def.colors != colors)		a["clickPhotonColors"] = colors;
@@ -557,8 +796,12 @@ void LoggerConfig::load(FPSciAnyTableReader reader, int settingsVersion) {
 		reader.getIfPresent("logFrameInfo", logFrameInfo);
 		reader.getIfPresent("logPlayerActions", logPlayerActions);
 		reader.getIfPresent("logTrialResponse", logTrialResponse);
+		reader.getIfPresent("logRenderCosts", logRenderCosts);
+		reader.getIfPresent("logEstimatedLatency", logEstimatedLatency);
 		reader.getIfPresent("logUsers", logUsers);
 		reader.getIfPresent("logOnChange", logOnChange);
+		reader.getIfPresent("logOnChangeViewTolerance", logOnChangeViewTolerance);
+		reader.getIfPresent("logOnChangePositionTolerance", logOnChangePositionTolerance);
 		reader.getIfPresent("logSessionDropDownUpdate", logSessDDUpdate);
 		reader.getIfPresent("sessionParametersToLog", sessParamsToLog);
 		reader.getIfPresent("trialParametersToLog", trialParamsToLog);
@@ -577,8 +820,12 @@ Any LoggerConfig::addToAny(Any a, bool forceAll) const {
 	if (forceAll || def.logFrameInfo != logFrameInfo)					a["logFrameInfo"] = logFrameInfo;
 	if (forceAll || def.logPlayerActions != logPlayerActions)			a["logPlayerActions"] = logPlayerActions;
 	if (forceAll || def.logTrialResponse != logTrialResponse)			a["logTrialResponse"] = logTrialResponse;
+	if (forceAll || def.logRenderCosts != logRenderCosts)				a["logRenderCosts"] = logRenderCosts;
+	if (forceAll || def.logEstimatedLatency != logEstimatedLatency)		a["logEstimatedLatency"] = logEstimatedLatency;
 	if (forceAll || def.logUsers != logUsers)							a["logUsers"] = logUsers;
 	if (forceAll || def.logOnChange != logOnChange)						a["logOnChange"] = logOnChange;
+	if (forceAll || def.logOnChangeViewTolerance != logOnChangeViewTolerance)			a["logOnChangeViewTolerance"] = logOnChangeViewTolerance;
+	if (forceAll || def.logOnChangePositionTolerance != logOnChangePositionTolerance)	a["logOnChangePositionTolerance"] = logOnChangePositionTolerance;
 	if (forceAll || def.sessParamsToLog != sessParamsToLog)				a["sessionParametersToLog"] = sessParamsToLog;
 	if (forceAll || def.trialParamsToLog != trialParamsToLog)			a["trialParametersToLog"] = trialParamsToLog;
 	if (forceAll || def.logSessDDUpdate != logSessDDUpdate)				a["logSessionDropDownUpdate"] = logSessDDUpdate;
@@ -592,6 +839,8 @@ CommandSpec::CommandSpec(const Any& any) {
 		reader.get("command", cmdStr, "A command string must be specified!");
 		reader.getIfPresent("foreground", foreground);
 		reader.getIfPresent("blocking", blocking);
+		// Windows environment variables (i.e. %DATE%) are passed through to the command
+		command = MessageTemplate(cmdStr, MessageTemplate::commandVars(), "command", true);
 	}
 	catch (ParseError e) {
 		// Handle errors related to older (pure) string-based commands
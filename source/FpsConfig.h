@@ -4,6 +4,7 @@
 #include "GuiElements.h"
 #include "UserConfig.h"
 #include "FPSciAnyTableReader.h"
+#include "MessageTemplate.h"
 
 class SceneConfig {
 public:
@@ -24,14 +25,83 @@ public:
 	bool operator!=(const SceneConfig& other) const;
 };
 
+/** A single (post-processing) shader pass, run in one of the render stages ("3D", "2D", or "composite") */
+struct ShaderPassConfig {
+	String			name;												///< Name of the pass (also names its output for use as another pass' input)
+	String			stage = "3D";										///< Stage to run the pass in ("3D", "2D", or "composite", case insensitive)
+	String			shader = "";										///< Filename of the shader to run (or empty to only resample the input)
+	String			input = "";											///< Name of an earlier pass (in this stage) to use as input (empty for the previous pass/stage input)
+	Array<int>		resolution = { 0, 0 };								///< Output resolution (0 to use the input resolution)
+	Sampler			sampler = Sampler::video();							///< Sampler for the (iChannel0) input
+
+	ShaderPassConfig() {};
+	ShaderPassConfig(const Any& any);
+
+	Any toAny(const bool forceAll = false) const;
+	bool operator!=(const ShaderPassConfig& other) const;
+};
+
+/** A named frame time profile, compiled into a flat per-frame schedule at the start of each trial (see FrameTimeSchedule) */
+struct FrameTimeProfileConfig {
+	enum class Type { Step, Ramp, Stutter, Trace };
+	static const Array<String>& typeNames() {
+		static const Array<String> names = { "step", "ramp", "stutter", "trace" };
+		return names;
+	}
+	enum class Distribution { Constant, Uniform, Exponential };
+	static const Array<String>& distributionNames() {
+		static const Array<String> names = { "constant", "uniform", "exponential" };
+		return names;
+	}
+
+	String			name;												///< Name of the profile (selected using RenderConfig::frameTimeProfile)
+	Type			type = Type::Step;									///< Type of profile ("step", "ramp", "stutter", or "trace", case insensitive)
+	Array<float>	times;												///< Times (in seconds from the start of the task) of each frame time keypoint ("step" and "ramp" only)
+	Array<float>	frameTimes;											///< Frame times (in seconds) for each keypoint, the base frame time ("stutter"), or the frame times to replay ("trace")
+	String			traceFile = "";										///< File to load a trace from instead of frameTimes ("trace" only, one frame time per line or a CSV column, in ms)
+	String			traceColumn = "MsBetweenPresents";					///< Column of a CSV trace file to replay
+	float			stutterPeriod = 0.0f;								///< Time (in seconds) between stutter frames (0 for no stutter)
+	float			stutterAmplitude = 0.0f;							///< Mean time (in seconds) added to each stutter frame
+	Distribution	stutterDistribution = Distribution::Constant;		///< Distribution of the stutter time ("constant", "uniform", or "exponential", case insensitive)
+	float			duration = 0.0f;									///< Duration (in seconds) of the profile (0 to end at the last keypoint/trace frame, or the max trial duration for "stutter")
+	bool			loop = false;										///< Restart the profile when it ends (otherwise hold the final frame time)
+
+	Array<float>	trace;												///< Frame times (in seconds) loaded from the traceFile (not serialized)
+
+	FrameTimeProfileConfig() {};
+	FrameTimeProfileConfig(const Any& any);
+
+	Any toAny(const bool forceAll = false) const;
+	bool operator!=(const FrameTimeProfileConfig& other) const;
+
+	/** Parse a trace of frame times (in ms) from either one value per line or a CSV file with a header row (using the provided column) */
+	static Array<float> parseTrace(const String& text, const String& column);
+};
+
 class RenderConfig {
 public:
+	enum class FrameTimeMode { Always, TaskOnly, RestartWithTask };
+	static const Array<String>& frameTimeModeNames() {
+		static const Array<String> names = { "always", "taskOnly", "restartWithTask" };
+		return names;
+	}
+	enum class FramePacing { Sleep, Hybrid, Spin };
+	static const Array<String>& framePacingNames() {
+		static const Array<String> names = { "sleep", "hybrid", "spin" };
+		return names;
+	}
+
 	// Rendering parameters
 	float           frameRate = 1000.0f;						///< Target (goal) frame rate (in Hz)
 	int             frameDelay = 0;								///< Integer frame delay (in frames)
+	float			frameDelayMs = 0.0f;						///< Display latency to add (in ms), overrides frameDelay when > 0
 	Array<float>	frameTimeArray = { };						///< Array of target frame times (in seconds)
 	bool			frameTimeRandomize = false;					///< Whether to choose a sequential or random item from frameTimeArray
-	String			frameTimeMode = "always";					///< Mode to use for frame time selection (can be "always", "taskOnly", or "restartWithTask", case insensitive)
+	FrameTimeMode	frameTimeMode = FrameTimeMode::Always;		///< Mode to use for frame time selection (can be "always", "taskOnly", or "restartWithTask", case insensitive)
+	Array<FrameTimeProfileConfig> frameTimeProfiles;			///< Named frame time profiles (selected using frameTimeProfile)
+	String			frameTimeProfile = "";						///< Name of the frame time profile to use (replaces frameTimeArray when set)
+	FramePacing		framePacing = FramePacing::Sleep;			///< Strategy used to wait for the target frame time (can be "sleep", "hybrid", or "spin", case insensitive)
+	float			framePacingSpinMs = 2.0f;					///< Time (in ms) to spin at the end of each frame wait in "hybrid" frame pacing
 
 	float           hFoV = 103.0f;							    ///< Field of view (horizontal) for the user
 	
@@ -52,9 +122,14 @@ public:
 	Sampler			samplerComposite = Sampler::video();		///< Sampler for sampling the shaderComposite iChannel0 input
 	Sampler			samplerFinal = Sampler::video();			///< Sampler for sampling composite (shader) output buffer into the final framebuffer
 
+	Array<ShaderPassConfig> shaderPasses;						///< Ordered list of shader passes (replaces the shader/sampler/resolution3D settings above when non-empty)
+
 	void load(FPSciAnyTableReader reader, int settingsVersion = 1);
 	Any addToAny(Any a, bool forceAll = false) const;
 
+	/** Get the ordered passes to run in a stage ("3D", "2D", or "composite"), from shaderPasses or the individual shader settings */
+	Array<ShaderPassConfig> stagePasses(const String& stage) const;
+
 };
 
 class PlayerConfig {
@@ -92,10 +167,26 @@ struct StaticHudElement {
 
 class HudConfig {
 public:
+	enum class BannerTimerMode { Remaining, Elapsed, None };
+	static const Array<String>& bannerTimerModeNames() {
+		static const Array<String> names = { "remaining", "elapsed", "none" };
+		return names;
+	}
+	enum class CooldownMode { Ring, Box };
+	static const Array<String>& cooldownModeNames() {
+		static const Array<String> names = { "ring", "box" };
+		return names;
+	}
+	enum class Side { Left, Right };
+	static const Array<String>& sideNames() {
+		static const Array<String> names = { "left", "right" };
+		return names;
+	}
+
 	// HUD parameters
 	bool            enable = false;											///< Master control for all HUD elements
 	bool            showBanner = false;						                ///< Show the banner display
-	String			bannerTimerMode = "remaining";							///< Time to show in the banner ("remaining", "elapsed", or "none")
+	BannerTimerMode	bannerTimerMode = BannerTimerMode::Remaining;			///< Time to show in the banner ("remaining", "elapsed", or "none")
 	bool			bannerShowProgress = true;								///< Show progress in banner?
 	bool			bannerShowScore = true;									///< Show score in banner?
 	float           bannerVertVisible = 0.41f;				                ///< Vertical banner visibility
@@ -121,8 +212,8 @@ public:
 	Color4          ammoColor = Color4(1.0, 1.0, 1.0, 1.0);						///< Color for ammo indicator text
 	Color4          ammoOutlineColor = Color4(0.0, 0.0, 0.0, 1.0);				///< Outline color for ammo indicator text
 	bool            renderWeaponStatus = true;									///< Display weapon cooldown
-	String          cooldownMode = "ring";										///< Currently "ring" and "box" are supported
-	String          weaponStatusSide = "left";									///< Only applied in "box" mode, can be "right" or "left"
+	CooldownMode    cooldownMode = CooldownMode::Ring;							///< Currently "ring" and "box" are supported
+	Side            weaponStatusSide = Side::Left;								///< Only applied in "box" mode, can be "right" or "left"
 	float           cooldownInnerRadius = 40.0f;								///< Inner radius for cooldown ring
 	float           cooldownThickness = 10.0f;									///< Thickness of cooldown ring
 	int             cooldownSubdivisions = 64;									///< Number of polygon divisions in the "ring"
@@ -200,6 +291,24 @@ public:
 	Color4 outlineColor = Color4::clear();							///< Color to draw the feedback message background
 	Color4 backgroundColor = Color4(0.0f, 0.0f, 0.0f, 0.5f);		///< Background color
 
+	// Feedback messages compiled at load (rendered by Session::formatFeedback())
+	MessageTemplate initialWithRefMsg;
+	MessageTemplate initialNoRefMsg;
+	MessageTemplate aimInvalidMsg;
+	MessageTemplate trialSuccessMsg;
+	MessageTemplate trialFailureMsg;
+	MessageTemplate taskSuccessMsg;
+	MessageTemplate taskFailureMsg;
+	MessageTemplate blockCompleteMsg;
+	MessageTemplate sessCompleteMsg;
+	MessageTemplate allSessCompleteMsg;
+
+	/** Uses the default messages (compiled once, then shared by all default configs) */
+	FeedbackConfig();
+
+	/** Compile the (changed) feedback messages (throws if a message contains an unknown substring) */
+	void compileMessages();
+
 	void load(FPSciAnyTableReader reader, int settingsVersion = 1);
 	Any addToAny(Any a, bool forceAll = false) const;
 };
@@ -265,10 +374,21 @@ public:
 
 class ClickToPhotonConfig {
 public:
+	enum class Side { Left, Right };
+	static const Array<String>& sideNames() {
+		static const Array<String> names = { "left", "right" };
+		return names;
+	}
+	enum class Mode { Minimum, Total, Both, FrameRate };
+	static const Array<String>& modeNames() {
+		static const Array<String> names = { "minimum", "total", "both", "frameRate" };
+		return names;
+	}
+
 	// Click-to-photon
 	bool            enabled = false;                            ///< Render click to photon box
-	String          side = "right";                             ///< "right" for right side, otherwise left
-	String			mode = "total";								///< Mode used to signal either minimum system latency ("minimum"), or added latency ("total"), or "both"
+	Side            side = Side::Right;                         ///< "right" for right side, or "left"
+	Mode			mode = Mode::Total;							///< Mode used to signal either minimum system latency ("minimum"), added latency ("total"), "both", or "frameRate" (toggle every frame)
 	Point2          size = Point2(0.05f, 0.035f);				///< Size of the click-to-photon area (ratio of screen space)
 	float           vertPos = 0.5f;				                ///< Percentage of the screen down to locate the box
 	Array<Color3>   colors = {				                    ///< Colors to apply to click to photon box
@@ -288,8 +408,12 @@ public:
 	bool logFrameInfo = true;			///< Log frame info in table?
 	bool logPlayerActions = true;		///< Log player actions in table?
 	bool logTrialResponse = true;		///< Log trial response in table?
+	bool logRenderCosts = true;			///< Log per-trial render pass timing in table?
+	bool logEstimatedLatency = true;	///< Log (software) estimated click-to-present latency for each shot in table?
 	bool logUsers = true;				///< Log user information in table?
 	bool logOnChange = false;			///< Only log to Player_Action/Target_Trajectory table when the player/target position/orientation changes
+	float logOnChangeViewTolerance = 0.0f;		///< Change in player view direction (in deg) ignored by logOnChange (for the Player_Action table)
+	float logOnChangePositionTolerance = 0.0f;	///< Change in player position (in m) ignored by logOnChange (for the Player_Action table)
 	bool logSessDDUpdate = false;		///< Log the session drop-down update (on each session complete)
 
 	bool logToSingleDb = true;			///< Log all results to a single db file?
@@ -305,6 +429,7 @@ public:
 class CommandSpec {
 public:
 	String	cmdStr;										///< Command string
+	MessageTemplate command;							///< Command string compiled at load (rendered by Session::formatCommand())
 	bool foreground = false;							///< Flag to indicate foreground vs background
 	bool blocking = false;								///< Flag to indicate to block on this process complete
 
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <G3D/G3D.h>
+#include <deque>
+
+/** Histogram of frame pacing error (actual - desired wait time) in fixed width bins.
+	Errors outside of the histogram range are counted in the first/last bin. */
+class FramePacingHistogram {
+public:
+	static const int BIN_COUNT = 32;						///< Number of bins in the histogram
+	static constexpr float BIN_WIDTH_S = 0.00025f;			///< Width of each bin (0.25ms)
+	static constexpr float MIN_ERROR_S = -0.001f;			///< Error at the start of the first bin (-1ms)
+
+protected:
+	int		m_bins[BIN_COUNT] = { 0 };						///< Count of samples in each bin
+	int		m_count = 0;									///< Total count of samples
+	double	m_sum = 0.0;									///< Sum of all samples (for mean)
+	float	m_max = -finf();								///< Maximum error recorded
+
+public:
+	/** Add an error sample (in seconds) */
+	void add(float error) {
+		const int bin = clamp(int(floor((error - MIN_ERROR_S) / BIN_WIDTH_S)), 0, BIN_COUNT - 1);
+		m_bins[bin]++;
+		m_count++;
+		m_sum += error;
+		m_max = max(m_max, error);
+	}
+
+	void clear() {
+		for (int i = 0; i < BIN_COUNT; i++) { m_bins[i] = 0; }
+		m_count = 0;
+		m_sum = 0.0;
+		m_max = -finf();
+	}
+
+	int count() const { return m_count; }
+	int binCount(int bin) const { return m_bins[bin]; }
+	/** Get the (lower edge) error value for a bin */
+	static float binStart(int bin) { return MIN_ERROR_S + bin * BIN_WIDTH_S; }
+
+	float mean() const { return m_count > 0 ? float(m_sum / m_count) : 0.0f; }
+	float maximum() const { return m_count > 0 ? m_max : 0.0f; }
+
+	/** Get the error at a given percentile (0-1), returned as the upper edge of the bin containing it */
+	float percentile(float p) const {
+		if (m_count == 0) return 0.0f;
+		const int target = max(1, iCeil(p * m_count));
+		int total = 0;
+		for (int i = 0; i < BIN_COUNT; i++) {
+			total += m_bins[i];
+			if (total >= target) return binStart(i + 1);
+		}
+		return binStart(BIN_COUNT);
+	}
+};
+
+/** Sliding window over the most recent frame durations that tracks the minimum and maximum in O(1) (amortized)
+	using monotonic deques, instead of rescanning the window every frame. */
+class FrameTimeWindow {
+protected:
+	struct Sample {
+		int64	index;											///< Index of the sample (in order added)
+		float	value;											///< Sample value
+	};
+
+	int					m_length;								///< Number of samples in the window
+	int64				m_added = 0;							///< Total count of samples added
+	std::deque<Sample>	m_min;									///< Minimum candidates (increasing values, oldest first)
+	std::deque<Sample>	m_max;									///< Maximum candidates (decreasing values, oldest first)
+
+public:
+	FrameTimeWindow(int length) : m_length(length) {}
+
+	/** Add a sample, expiring any sample that has left the window */
+	void add(float value) {
+		const int64 index = m_added++;
+		while (!m_min.empty() && m_min.back().value >= value) { m_min.pop_back(); }
+		m_min.push_back({ index, value });
+		while (!m_max.empty() && m_max.back().value <= value) { m_max.pop_back(); }
+		m_max.push_back({ index, value });
+
+		// At most one sample leaves the window per sample added
+		const int64 first = index - m_length + 1;
+		if (m_min.front().index < first) { m_min.pop_front(); }
+		if (m_max.front().index < first) { m_max.pop_front(); }
+	}
+
+	void clear() {
+		m_added = 0;
+		m_min.clear();
+		m_max.clear();
+	}
+
+	/** Number of samples currently in the window */
+	int size() const { return int(min(m_added, int64(m_length))); }
+	float minimum() const { return m_min.empty() ? 0.0f : m_min.front().value; }
+	float maximum() const { return m_max.empty() ? 0.0f : m_max.front().value; }
+};
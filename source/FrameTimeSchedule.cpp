@@ -0,0 +1,116 @@
+#include "FrameTimeSchedule.h"
+
+void FrameTimeSchedule::compile(const RenderConfig& config, float baseFrameTime) {
+	m_mode = config.frameTimeMode;
+	m_baseFrameTime = baseFrameTime;
+	m_randomize = false;
+	m_profile = false;
+	m_minFrameTime = finf();
+
+	if (!config.frameTimeProfile.empty()) {
+		for (const FrameTimeProfileConfig& profile : config.frameTimeProfiles) {
+			if (profile.name != config.frameTimeProfile) continue;
+			compileProfile(profile);
+			break;
+		}
+	}
+	else {
+		// Use the frame time array directly (keeping our place in it across trials, as it is cycled continuously)
+		m_frameTimes = config.frameTimeArray;
+		m_randomize = config.frameTimeRandomize;
+		m_loop = true;
+		m_holdFrameTime = baseFrameTime;
+		m_idx = m_frameTimes.size() > 0 ? m_idx % m_frameTimes.size() : 0;
+	}
+
+	m_active = m_profile || m_frameTimes.size() > 0;
+	float maxFrameTime = 0.0f;
+	for (float frameTime : m_frameTimes) {
+		if (frameTime > 0.0f) m_minFrameTime = min(m_minFrameTime, frameTime);
+		maxFrameTime = max(maxFrameTime, frameTime);
+	}
+	if (m_profile && m_holdFrameTime > 0.0f) m_minFrameTime = min(m_minFrameTime, m_holdFrameTime);
+
+	// Label the condition by what actually drives the frame time
+	if (m_profile) m_condition = config.frameTimeProfile;
+	else if (!m_active || maxFrameTime <= 0.0f) m_condition = format("%.0f fps", 1.0f / baseFrameTime);
+	else if (maxFrameTime - m_minFrameTime < 1e-6f) m_condition = format("%.0f fps", 1.0f / maxFrameTime);
+	else m_condition = format("%.0f-%.0f fps", 1.0f / maxFrameTime, 1.0f / m_minFrameTime);
+}
+
+void FrameTimeSchedule::compileProfile(const FrameTimeProfileConfig& profile) {
+	m_profile = true;
+	m_loop = profile.loop;
+	m_idx = 0;
+	m_frameTimes.fastClear();
+
+	const bool isTrace = profile.type == FrameTimeProfileConfig::Type::Trace;
+	const Array<float>& trace = profile.trace.size() > 0 ? profile.trace : profile.frameTimes;
+
+	// Find the time at which the profile ends
+	double endTime = profile.duration;
+	if (endTime <= 0.0) {
+		if (profile.type == FrameTimeProfileConfig::Type::Stutter) {
+			// Stutter profiles run for the whole trial, so compile a window of stutter periods and loop it
+			endTime = profile.stutterPeriod > 0.0f ? STUTTER_LOOP_PERIODS * profile.stutterPeriod : 0.0;
+			m_loop = true;
+		}
+		else if (!isTrace) endTime = profile.times.last();
+		else endTime = finf();		// Play the entire trace
+	}
+
+	// Step through the profile in simulated time, producing one frame time per frame
+	double time = 0.0;
+	double nextStutter = profile.stutterPeriod;
+	int traceIdx = 0;
+	while (m_frameTimes.size() < MAX_FRAMES && time < endTime) {
+		float frameTime;
+		if (isTrace) {
+			if (traceIdx >= trace.size()) break;
+			frameTime = trace[traceIdx++];
+		}
+		else {
+			frameTime = baseFrameTimeAt(profile, time, m_baseFrameTime);
+		}
+		if (profile.stutterPeriod > 0.0f && time + frameTime >= nextStutter) {
+			frameTime += drawStutter(profile);
+			nextStutter += profile.stutterPeriod;
+		}
+		m_frameTimes.append(frameTime);
+		time += frameTime;
+	}
+
+	m_holdFrameTime = isTrace ? trace.last() : baseFrameTimeAt(profile, endTime, m_baseFrameTime);
+}
+
+float FrameTimeSchedule::baseFrameTimeAt(const FrameTimeProfileConfig& profile, double time, float baseFrameTime) {
+	if (profile.type == FrameTimeProfileConfig::Type::Stutter) {
+		return profile.frameTimes.size() > 0 ? profile.frameTimes[0] : baseFrameTime;
+	}
+
+	// Find the last keypoint at or before this time (use the base frame time before the first keypoint)
+	const Array<float>& times = profile.times;
+	int i = times.size() - 1;
+	while (i >= 0 && times[i] > time) { i--; }
+	if (i < 0) {
+		if (profile.type == FrameTimeProfileConfig::Type::Ramp) return profile.frameTimes[0];	// Ramps hold their first value until it starts
+		return baseFrameTime;
+	}
+	if (profile.type == FrameTimeProfileConfig::Type::Ramp && i < times.size() - 1) {
+		// Linearly interpolate between this keypoint and the next
+		const float a = float((time - times[i]) / max(times[i + 1] - times[i], 1e-6f));
+		return lerp(profile.frameTimes[i], profile.frameTimes[i + 1], a);
+	}
+	return profile.frameTimes[i];
+}
+
+float FrameTimeSchedule::drawStutter(const FrameTimeProfileConfig& profile) {
+	switch (profile.stutterDistribution) {
+	case FrameTimeProfileConfig::Distribution::Uniform:
+		return Random::common().uniform(0.0f, 2.0f * profile.stutterAmplitude);
+	case FrameTimeProfileConfig::Distribution::Exponential:
+		return -profile.stutterAmplitude * log(max(1.0f - Random::common().uniform(), 1e-6f));
+	default:
+		return profile.stutterAmplitude;
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <G3D/G3D.h>
+#include "FpsConfig.h"
+
+/** Per-frame target frame time schedule, compiled from a RenderConfig (frame time profile or frameTimeArray) at the start of each trial.
+	Profiles are resolved when compiling, so the per-frame lookup (next()) is a single array index. */
+class FrameTimeSchedule {
+public:
+	static const int MAX_FRAMES = 1 << 18;							///< Maximum number of frames to compile for a profile (hold/loop after this)
+	static const int STUTTER_LOOP_PERIODS = 8;						///< Stutter periods compiled (and looped) for stutter profiles without a duration
+	using Mode = RenderConfig::FrameTimeMode;
+
+protected:
+	Array<float>	m_frameTimes;									///< Compiled frame times (in seconds)
+	int				m_idx = 0;										///< Index of the next frame time
+	bool			m_active = false;								///< Is a schedule (profile or frameTimeArray) in use?
+	bool			m_profile = false;								///< Was the schedule compiled from a profile (restarts with each task)?
+	bool			m_loop = false;									///< Restart the schedule when it ends?
+	bool			m_randomize = false;							///< Choose a random frame time instead of stepping through the schedule
+	Mode			m_mode = Mode::Always;							///< Frame time mode (from the render config)
+	float			m_holdFrameTime = 0.0f;							///< Frame time to hold after the schedule ends (when not looping)
+	float			m_baseFrameTime = 0.0f;							///< Frame time to use outside of the task (for task-only modes)
+	float			m_minFrameTime = finf();						///< Minimum compiled frame time
+	String			m_condition;									///< Frame rate condition label (profile name, or frame rate(s) used)
+
+	/** Get the (un-stuttered) frame time for a step/ramp/stutter profile at a given time */
+	static float baseFrameTimeAt(const FrameTimeProfileConfig& profile, double time, float baseFrameTime);
+	/** Draw a stutter duration from the profile's distribution */
+	static float drawStutter(const FrameTimeProfileConfig& profile);
+
+	void compileProfile(const FrameTimeProfileConfig& profile);
+
+public:
+	/** Compile the schedule for a render config, using baseFrameTime outside of the task */
+	void compile(const RenderConfig& config, float baseFrameTime);
+
+	/** Get the next frame time (in seconds), inTask indicates whether the session is in the task state */
+	float next(bool inTask) {
+		if (m_mode != Mode::Always && !inTask) return m_baseFrameTime;
+		if (m_randomize) return m_frameTimes.randomElement();
+		if (m_idx >= m_frameTimes.size()) {
+			if (!m_loop || m_frameTimes.size() == 0) return m_holdFrameTime;
+			m_idx = 0;
+		}
+		return m_frameTimes[m_idx++];
+	}
+
+	/** Called at the start of each task, restarts the schedule when requested (or for profiles) */
+	void startTask() {
+		if (m_profile || m_mode == Mode::RestartWithTask) m_idx = 0;
+	}
+
+	bool active() const { return m_active; }
+	int size() const { return m_frameTimes.size(); }
+	const Array<float>& frameTimes() const { return m_frameTimes; }
+	float holdFrameTime() const { return m_holdFrameTime; }
+	float minFrameTime() const { return m_minFrameTime; }
+	/** Label for the frame rate condition of this schedule (i.e. "60 fps", "30-60 fps", or the profile name) */
+	const String& condition() const { return m_condition; }
+};
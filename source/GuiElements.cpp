@@ -305,7 +305,7 @@ WeaponControls::WeaponControls(WeaponConfig& config, const shared_ptr<GuiTheme>&
 	} pane->endRow();
 	pane->beginRow(); {
 		pane->addNumberBox("Fire Spread", &(config.fireSpreadDegrees), "\xB0", GuiTheme::LINEAR_SLIDER, 0.f, 120.f, 0.1f);
-		m_spreadShapeIdx = m_spreadShapes.findIndex(m_config.fireSpreadShape);
+		m_spreadShapeIdx = int(m_config.fireSpreadShape);
 		pane->addDropDownList("Spread Shape", m_spreadShapes, &m_spreadShapeIdx, std::bind(&WeaponControls::updateFireSpreadShape, this));
 	} pane->endRow();
 	//pane->beginRow(); {
@@ -330,7 +330,7 @@ WeaponControls::WeaponControls(WeaponConfig& config, const shared_ptr<GuiTheme>&
 }
 
 void WeaponControls::updateFireSpreadShape() {
-	m_config.fireSpreadShape = m_spreadShapes[m_spreadShapeIdx];
+	m_config.fireSpreadShape = WeaponConfig::SpreadShape(m_spreadShapeIdx);
 }
 
 void MenuConfig::load(FPSciAnyTableReader reader, int settingsVersion) {
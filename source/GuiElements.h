@@ -139,7 +139,7 @@ public:
 class WeaponControls : public GuiWindow {
 protected:
 	int	m_spreadShapeIdx = 0;											// Index of fire spread shape
-	const Array<String> m_spreadShapes = { "uniform", "gaussian" };		// Optional shapes to select from
+	const Array<String> m_spreadShapes = WeaponConfig::spreadShapeNames();		// Optional shapes to select from
 	void updateFireSpreadShape(void);
 
 	WeaponConfig& m_config;
@@ -0,0 +1,70 @@
+#include "HudBatch.h"
+
+void HudBatch::addTriangle(const Vector2& a, const Vector2& b, const Vector2& c, const Color4& color) {
+	m_positions.append(a, b, c);
+	m_colors.append(color, color, color);
+}
+
+void HudBatch::addRect(const Rect2D& rect, const Color4& color) {
+	addTriangle(rect.corner(0), rect.corner(1), rect.corner(2), color);
+	addTriangle(rect.corner(0), rect.corner(2), rect.corner(3), color);
+}
+
+void HudBatch::addPoly(const Array<Vector2>& verts, const Color4& color) {
+	for (int i = 1; i < verts.size() - 1; i++) {
+		addTriangle(verts[0], verts[i], verts[i + 1], color);
+	}
+}
+
+const Array<Vector2>& HudBatch::ringDirections(int subdivisions) {
+	bool created = false;
+	Array<Vector2>& dirs = m_ringDirections.getCreate(subdivisions, created);
+	if (created) {
+		// Directions run clockwise from the top of the screen (y is down in window-space)
+		const float inc = static_cast<float>(2 * pi() / subdivisions);
+		dirs.resize(subdivisions + 1);
+		for (int i = 0; i <= subdivisions; i++) {
+			const float theta = -i * inc;
+			dirs[i] = Vector2(sin(theta), -cos(theta));
+		}
+	}
+	return dirs;
+}
+
+void HudBatch::addRing(const Vector2& center, float innerRadius, float outerRadius, int subdivisions, int segsToLight, const Color4& color) {
+	if (subdivisions <= 0) return;
+	const Array<Vector2>& dirs = ringDirections(subdivisions);
+	segsToLight = min(segsToLight, subdivisions);
+	for (int i = 0; i < segsToLight; i++) {
+		const Vector2 outer0 = center + outerRadius * dirs[i];
+		const Vector2 outer1 = center + outerRadius * dirs[i + 1];
+		const Vector2 inner1 = center + innerRadius * dirs[i + 1];
+		const Vector2 inner0 = center + innerRadius * dirs[i];
+		addTriangle(outer0, outer1, inner1, color);
+		addTriangle(outer0, inner1, inner0, color);
+	}
+}
+
+void HudBatch::draw(RenderDevice* rd) const {
+	if (m_positions.size() == 0) return;
+
+	// Upload positions and colors into a single vertex buffer (only reallocated when the batch outgrows it)
+	const size_t bytes = m_positions.size() * (sizeof(Vector2) + sizeof(Color4)) + 8;
+	if (isNull(m_vertexBuffer) || bytes > m_vertexBufferBytes) {
+		m_vertexBufferBytes = max(bytes, 2 * m_vertexBufferBytes);
+		m_vertexBuffer = VertexBuffer::create(m_vertexBufferBytes, VertexBuffer::WRITE_EVERY_FRAME);
+	}
+	else {
+		m_vertexBuffer->reset();
+	}
+	AttributeArray positions(m_positions, m_vertexBuffer);
+	AttributeArray colors(m_colors, m_vertexBuffer);
+
+	// Use the caller's blending state (as Draw::rect2D/poly2D do)
+	Args args;
+	args.setAttributeArray("position", positions);
+	args.setAttributeArray("color", colors);
+	args.setPrimitiveType(PrimitiveType::TRIANGLES);
+	args.setNumIndices(m_positions.size());
+	LAUNCH_SHADER("hudBatch.*", args);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <G3D/G3D.h>
+
+/** Batches solid-colored HUD geometry (rectangles, polygons, and ring segments) into a single triangle list
+	that is drawn with one draw call. Building the batch doesn't require a RenderDevice (only drawing does). */
+class HudBatch {
+protected:
+	Array<Vector2>					m_positions;			///< Triangle list vertex positions (window-space)
+	Array<Color4>					m_colors;				///< Triangle list vertex colors
+	Table<int, Array<Vector2>>		m_ringDirections;		///< Cached unit ring directions (by subdivision count)
+	mutable shared_ptr<VertexBuffer>	m_vertexBuffer;		///< Vertex buffer reused by draw() (sized to the high-water mark)
+	mutable size_t					m_vertexBufferBytes = 0;	///< Size of m_vertexBuffer (in bytes)
+
+	void addTriangle(const Vector2& a, const Vector2& b, const Vector2& c, const Color4& color);
+
+public:
+	/** Remove all geometry from the batch (cached ring geometry is kept) */
+	void clear() {
+		m_positions.fastClear();
+		m_colors.fastClear();
+	}
+
+	/** Add a rectangle (as 2 triangles) */
+	void addRect(const Rect2D& rect, const Color4& color);
+	/** Add a convex polygon (as a triangle fan) */
+	void addPoly(const Array<Vector2>& verts, const Color4& color);
+	/** Add the first segsToLight segments of a ring (clockwise from the top) with the given subdivision count */
+	void addRing(const Vector2& center, float innerRadius, float outerRadius, int subdivisions, int segsToLight, const Color4& color);
+
+	/** Get the (cached) unit directions for the vertices of a ring with the given subdivision count (subdivisions + 1 directions) */
+	const Array<Vector2>& ringDirections(int subdivisions);
+
+	int vertexCount() const { return m_positions.size(); }
+	const Array<Vector2>& positions() const { return m_positions; }
+	const Array<Color4>& colors() const { return m_colors; }
+
+	/** Draw all geometry in the batch (in a single draw call) to the current 2D render target */
+	void draw(RenderDevice* rd) const;
+};
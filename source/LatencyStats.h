@@ -0,0 +1,117 @@
+#pragma once
+
+#include <G3D/G3D.h>
+#include <mutex>
+
+/** Streaming quantile sketch for latencies, using logarithmically spaced bins so any quantile is reported to within
+	RELATIVE_ERROR of its true value in constant memory (samples themselves are never stored). */
+class LatencySketch {
+public:
+	static constexpr float MIN_MS = 0.1f;						///< Smallest latency resolved (smaller values count in the first bin)
+	static constexpr float RELATIVE_ERROR = 0.01f;				///< Relative accuracy of reported quantiles
+	static const int BIN_COUNT = 512;							///< Number of bins (covers MIN_MS up to ~2.7 seconds)
+
+protected:
+	int		m_bins[BIN_COUNT] = { 0 };							///< Count of samples in each bin
+	int		m_count = 0;										///< Total count of samples
+	float	m_min = finf();										///< Minimum sample
+	float	m_max = -finf();									///< Maximum sample
+
+	static float gamma() { return (1.0f + RELATIVE_ERROR) / (1.0f - RELATIVE_ERROR); }
+
+public:
+	/** Add a latency sample (in ms) */
+	void add(float ms) {
+		static const float logGamma = log(gamma());
+		const int bin = ms <= MIN_MS ? 0 : clamp(int(ceil(log(ms / MIN_MS) / logGamma)), 0, BIN_COUNT - 1);
+		m_bins[bin]++;
+		m_count++;
+		m_min = min(m_min, ms);
+		m_max = max(m_max, ms);
+	}
+
+	void clear() {
+		for (int i = 0; i < BIN_COUNT; i++) { m_bins[i] = 0; }
+		m_count = 0;
+		m_min = finf();
+		m_max = -finf();
+	}
+
+	int count() const { return m_count; }
+	float minimum() const { return m_count > 0 ? m_min : 0.0f; }
+	float maximum() const { return m_count > 0 ? m_max : 0.0f; }
+
+	/** Get the latency (in ms) at a given quantile (0-1), clamped to the observed range */
+	float quantile(float q) const {
+		if (m_count == 0) return 0.0f;
+		const int target = max(1, iCeil(q * m_count));
+		int total = 0;
+		for (int i = 0; i < BIN_COUNT; i++) {
+			total += m_bins[i];
+			if (total >= target) {
+				// Report the bin center (within RELATIVE_ERROR of any value in the bin)
+				const float value = i == 0 ? MIN_MS : 2.0f * MIN_MS * pow(gamma(), float(i)) / (gamma() + 1.0f);
+				return clamp(value, m_min, m_max);
+			}
+		}
+		return m_max;
+	}
+};
+
+/** Click-to-photon latency statistics for the current trial and for each frame rate condition in the session.
+	Latencies are added from the event logger's read thread, so all access is locked. */
+class ClickToPhotonStats {
+protected:
+	mutable std::mutex				m_mutex;
+	String							m_condition;				///< Current condition (i.e. "60 fps")
+	bool							m_inTrial = false;			///< Is a trial (task) in progress? Latencies are only recorded during trials
+	LatencySketch					m_trial;					///< Latencies measured during the current trial
+	Table<String, LatencySketch>	m_conditions;				///< Latencies measured for each condition (this session)
+
+public:
+	/** Add a latency (in ms) to the current trial and condition (ignored between trials) */
+	void add(float ms) {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		if (!m_inTrial) return;
+		m_trial.add(ms);
+		m_conditions.getCreate(m_condition).add(ms);
+	}
+
+	/** Start a new trial (under the given condition), clearing the trial statistics */
+	void startTrial(const String& condition) {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		m_condition = condition;
+		m_trial.clear();
+		m_inTrial = true;
+	}
+
+	/** End the current trial, latencies are ignored until the next trial starts (its statistics are kept until then) */
+	void endTrial() {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		m_inTrial = false;
+	}
+
+	/** Clear all statistics (i.e. at the start of a session) */
+	void clear() {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		m_trial.clear();
+		m_conditions.clear();
+		m_inTrial = false;
+	}
+
+	String condition() const {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		return m_condition;
+	}
+	/** Get a copy of the statistics for the current trial */
+	LatencySketch trial() const {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		return m_trial;
+	}
+	/** Get a copy of the statistics for the current condition */
+	LatencySketch currentCondition() const {
+		std::lock_guard<std::mutex> lk(m_mutex);
+		const LatencySketch* sketch = m_conditions.getPointer(m_condition);
+		return notNull(sketch) ? *sketch : LatencySketch();
+	}
+};
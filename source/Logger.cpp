@@ -40,6 +40,8 @@ String FPSciLogger::genFileTimestamp() {
 void FPSciLogger::initResultsFile(const String& filename, 
 	const String& subjectID, 
 	const String& expConfigFilename,
+	const String& expConfigHash,
+	const String& expDescription,
 	const shared_ptr<SessionConfig>& sessConfig, 
 	const String& description)
 {
@@ -50,21 +52,32 @@ void FPSciLogger::initResultsFile(const String& filename,
 		logPrintf(("Error opening log file: " + filename).c_str());					// Write an error to the log
 	}
 
+	// Build up array of all trial parameters to log
+	m_trialParams = sessConfig->logger.trialParamsToLog;
+	for (const TrialConfig& t : sessConfig->trials) {
+		for (const String& p : t.logger.trialParamsToLog) {
+			if (!m_trialParams.contains(p)) m_trialParams.append(p);
+		}
+	}
+
+	// Resolve the logged parameter values for each trial once here (trial configs don't change within a session)
+	m_trialParamValues.fastClear();
+	for (const TrialConfig& t : sessConfig->trials) {
+		RowEntry values;
+		if (m_trialParams.size() > 0) {
+			const Any a = t.toAny(true);
+			for (const String& p : m_trialParams) { values.append("'" + a[p].unparse() + "'"); }
+		}
+		m_trialParamValues.append(values);
+	}
+
 	// Create tables if a new log file is opened
 	if (createNewFile) {
-		createExperimentsTable(expConfigFilename);
+		createExperimentsTable(expConfigFilename, expConfigHash, expDescription);
 		createSessionsTable(sessConfig->logger.sessParamsToLog);
 		createTasksTable();
 		createTargetTypeTable();
 		createTargetsTable();
-		
-		// Build up array of all trial parameters to log
-		m_trialParams = sessConfig->logger.trialParamsToLog;
-		for (const TrialConfig& t : sessConfig->trials) {
-			for (const String& p : t.logger.trialParamsToLog) {
-				if (!m_trialParams.contains(p)) m_trialParams.append(p);
-			}
-		}
 		createTrialsTable(m_trialParams);
 		
 		createTargetTrajectoryTable();
@@ -72,6 +85,11 @@ void FPSciLogger::initResultsFile(const String& filename,
 		createFrameInfoTable();
 		createQuestionsTable();
 		createUsersTable();
+		createRenderCostsTable();
+		createEventsTable();
+		createClickLatenciesTable("Click_Latencies");
+		createClickLatenciesTable("Estimated_Click_Latencies");
+		createClickLatencyStatsTable();
 	}
 
 	// Add the session info to the sessions table
@@ -87,16 +105,17 @@ void FPSciLogger::initResultsFile(const String& filename,
 		"0"
 	};
 
-	// Create any table to do lookup here
-	Any a = sessConfig->toAny(true);
-	// Add the looked up values
-	for (const String& name : sessConfig->logger.sessParamsToLog) { sessValues.append("'" + a[name].unparse() + "'"); }
+	// Add the looked up values (only serialize the config if there are values to look up)
+	if (sessConfig->logger.sessParamsToLog.size() > 0) {
+		const Any a = sessConfig->toAny(true);
+		for (const String& name : sessConfig->logger.sessParamsToLog) { sessValues.append("'" + a[name].unparse() + "'"); }
+	}
 	// add header row
 	insertRowIntoDB(m_db, "Sessions", sessValues);
 
 }
 
-void FPSciLogger::createExperimentsTable(const String& expConfigFilename) {
+void FPSciLogger::createExperimentsTable(const String& expConfigFilename, const String& expConfigHash, const String& expDescription) {
 	// Create experiments table columns
 	Columns expColumns = {
 		{ "description", "text", "NOT NULL"},
@@ -107,15 +126,11 @@ void FPSciLogger::createExperimentsTable(const String& expConfigFilename) {
 	createTableInDB(m_db, "Experiments", expColumns);
 
 	// Currently this should just happen once per results file (hash is in name) but in the future we may want to check if the hash is in the the table...
-	// Load experiment config text and get hash
-	ExperimentConfig expConfig = ExperimentConfig::load(expConfigFilename);
-	const size_t hash = HashTrait<String>::hashCode(expConfig.toAny().unparse());		// Hash the serialized Any (don't consider formatting)
-
-	// Update row
+	// The hash is computed once when the experiment config is loaded (from the serialized Any, so formatting isn't considered)
 	RowEntry expRow = {
-		"'" + expConfig.description + "'",
+		"'" + expDescription + "'",
 		"'" + genUniqueTimestamp() + "'",
-		"'" + format("0x%x", hash) + "'",
+		"'0x" + expConfigHash + "'",
 		"'" + readWholeFile(expConfigFilename)  + "'"
 	};
 	insertRowIntoDB(m_db, "Experiments", expRow);
@@ -183,7 +198,7 @@ void FPSciLogger::logTargetTypes(const Array<shared_ptr<TargetConfig>>& targets)
 		const RowEntry targetTypeRow = {
 			"'" + config->id + "'",
 			"'" + type + "'",
-			"'" + config->destSpace + "'",
+			"'" + TargetConfig::destSpaceNames()[int(config->destSpace)] + "'",
 			String(std::to_string(config->size[0])),
 			String(std::to_string(config->size[1])),
 			config->symmetricEccH ? "true" : "false",
@@ -229,9 +244,8 @@ void FPSciLogger::addTarget(const String& name, const shared_ptr<TargetConfig>&
 	logTargetInfo(targetValues);
 }
 
-void FPSciLogger::addTrialParamValues(TrialValues& t, const shared_ptr<TrialConfig>& config) {
-	Any a = config->toAny(true);
-	for (const String& p : m_trialParams) { t.append("'" + a[p].unparse() + "'"); }
+void FPSciLogger::addTrialParamValues(TrialValues& t, int trialIdx) {
+	t.append(m_trialParamValues[trialIdx]);
 }
 
 void FPSciLogger::createTasksTable() {
@@ -291,7 +305,8 @@ void FPSciLogger::createTrialsTable(const Array<String>& trialParams) {
 		{ "pretrial_duration", "real" },
 		{ "task_execution_time", "real" },
 		{ "destroyed_targets", "integer" },
-		{ "total_targets", "integer" }
+		{ "total_targets", "integer" },
+		{ "start_frame_time", "real" }
 	};
 	for (String name : trialParams) { trialColumns.append({ "'" + name + "'", "text", "NOT NULL" }); }
 	createTableInDB(m_db, "Trials", trialColumns);
@@ -316,7 +331,7 @@ void FPSciLogger::recordTargetLocations(const Array<TargetLocation>& locations)
 		String stateStr = presentationStateToString(loc.state);
 		Array<String> targetTrajectoryValues = {
 			"'" + FPSciLogger::formatFileTime(loc.time) + "'",
-			"'" + loc.name + "'",
+			"'" + m_targetNames[loc.targetId] + "'",
 			"'" + stateStr + "'",
 			String(std::to_string(loc.position.x)),
 			String(std::to_string(loc.position.y)),
@@ -366,7 +381,7 @@ void FPSciLogger::recordPlayerActions(const Array<PlayerAction>& actions) {
 		String(std::to_string(action.position.z)),
 		"'" + stateStr + "'",
 		"'" + actionStr + "'",
-		"'" + action.targetName + "'",
+		"'" + m_targetNames[action.targetId] + "'",
 		};
 		rows.append(playerActionValues);
 	}
@@ -377,19 +392,45 @@ void FPSciLogger::createFrameInfoTable() {
 	// Frame_Info table
 	Columns frameInfoColumns = {
 		{"time", "text"},
-		//{"idt", "real"},
+		{"rdt", "real"},
 		{"sdt", "real"},
+		{"idt", "real"},
+		{"target_frame_time", "real"},
+		{"pacing_error", "real"},
+		{"user_input_time", "real"},
+		{"network_time", "real"},
+		{"logic_time", "real"},
+		{"simulation_time", "real"},
+		{"pose_time", "real"},
+		{"wait_time", "real"},
+		{"graphics_time", "real"},
+		{"delay_buffer_index", "integer"},
+		{"added_latency", "real"},
+		{"logger_queue_depth", "integer"},
 	};
 	createTableInDB(m_db, "Frame_Info", frameInfoColumns);
 }
 
 void FPSciLogger::recordFrameInfo(const Array<FrameInfo>& frameInfo) {
 	Array<RowEntry> rows;
-	for (FrameInfo info : frameInfo) {
+	for (const FrameInfo& info : frameInfo) {
 		Array<String> frameValues = {
 			"'" + FPSciLogger::formatFileTime(info.time) + "'",
-			//String(std::to_string(info.idt)),
-			String(std::to_string(info.sdt))
+			String(std::to_string(info.rdt)),
+			String(std::to_string(info.sdt)),
+			String(std::to_string(info.idt)),
+			String(std::to_string(info.targetFrameTime)),
+			String(std::to_string(info.pacingError)),
+			String(std::to_string(info.userInputTime)),
+			String(std::to_string(info.networkTime)),
+			String(std::to_string(info.logicTime)),
+			String(std::to_string(info.simulationTime)),
+			String(std::to_string(info.poseTime)),
+			String(std::to_string(info.waitTime)),
+			String(std::to_string(info.graphicsTime)),
+			String(std::to_string(info.delayBufferIndex)),
+			String(std::to_string(info.addedLatency)),
+			String(std::to_string(info.loggerQueueDepth))
 		};
 		rows.append(frameValues);
 	}
@@ -499,6 +540,91 @@ void FPSciLogger::logUserConfig(const UserConfig& user, const String& sessId, co
 	m_users.append(row);
 }
 
+void FPSciLogger::createRenderCostsTable() {
+	// Render costs table (per-pass timing for each trial)
+	Columns renderCostColumns = {
+		{ "session_id", "text" },
+		{ "task_id", "text" },
+		{ "task_index", "integer" },
+		{ "trial_id", "text" },
+		{ "trial_index", "integer" },
+		{ "pass", "text" },
+		{ "timing", "text" },
+		{ "samples", "integer" },
+		{ "p50_ms", "real" },
+		{ "p99_ms", "real" }
+	};
+	createTableInDB(m_db, "Render_Costs", renderCostColumns);
+}
+
+void FPSciLogger::createEventsTable() {
+	// Events table (raw events from the hardware event logger)
+	Columns eventColumns = {
+		{ "time", "text" },
+		{ "event", "text" }
+	};
+	createTableInDB(m_db, "Events", eventColumns);
+}
+
+void FPSciLogger::createClickLatenciesTable(const String& tableName) {
+	// Click latencies table (click-to-photon latency measured by the hardware event logger, or estimated in software)
+	Columns latencyColumns = {
+		{ "time", "text" },
+		{ "latency", "real" },
+		{ "latency_mode", "text" }
+	};
+	createTableInDB(m_db, tableName, latencyColumns);
+}
+
+void FPSciLogger::createClickLatencyStatsTable() {
+	// Click latency stats table (per-trial summary of the click-to-photon latency)
+	Columns statColumns = {
+		{ "session_id", "text" },
+		{ "task_id", "text" },
+		{ "task_index", "integer" },
+		{ "trial_id", "text" },
+		{ "trial_index", "integer" },
+		{ "condition", "text" },
+		{ "samples", "integer" },
+		{ "p50_ms", "real" },
+		{ "p95_ms", "real" },
+		{ "p99_ms", "real" }
+	};
+	createTableInDB(m_db, "Click_Latency_Stats", statColumns);
+}
+
+static FILETIME ticksToFileTime(uint64 ticks) {
+	FILETIME ft;
+	ft.dwLowDateTime = DWORD(ticks & 0xFFFFFFFF);
+	ft.dwHighDateTime = DWORD(ticks >> 32);
+	return ft;
+}
+
+void FPSciLogger::recordHardwareEvents(const Array<HardwareEvent>& events) {
+	if (events.size() == 0) return;		// Most sessions have no hardware logger
+	Array<RowEntry> rows;
+	for (const HardwareEvent& e : events) {
+		rows.append(RowEntry({
+			"'" + FPSciLogger::formatFileTime(ticksToFileTime(e.time)) + "'",
+			"'" + EventLogger::eventTypeNames()[int(e.type)] + "'"
+		}));
+	}
+	insertRowsIntoDB(m_db, "Events", rows);
+}
+
+void FPSciLogger::recordClickLatencies(const Array<ClickLatency>& latencies, const String& tableName) {
+	if (latencies.size() == 0) return;		// Nothing to write (no shots/hardware logger)
+	Array<RowEntry> rows;
+	for (const ClickLatency& l : latencies) {
+		rows.append(RowEntry({
+			"'" + FPSciLogger::formatFileTime(ticksToFileTime(l.time)) + "'",
+			String(std::to_string(l.latencyMs)),
+			"'" + l.mode + "'"
+		}));
+	}
+	insertRowsIntoDB(m_db, tableName, rows);
+}
+
 void FPSciLogger::loggerThreadEntry()
 {
 	std::unique_lock<std::mutex> lk(m_queueMutex);
@@ -539,17 +665,48 @@ void FPSciLogger::loggerThreadEntry()
 		users.swap(m_users, users);
 		m_users.reserve(users.size() * 2);
 
+		decltype(m_renderCosts) renderCosts;
+		renderCosts.swap(m_renderCosts, renderCosts);
+		m_renderCosts.reserve(renderCosts.size() * 2);
+
+		decltype(m_hardwareEvents) hardwareEvents;
+		hardwareEvents.swap(m_hardwareEvents, hardwareEvents);
+		m_hardwareEvents.reserve(hardwareEvents.size() * 2);
+
+		decltype(m_clickLatencies) clickLatencies;
+		clickLatencies.swap(m_clickLatencies, clickLatencies);
+		m_clickLatencies.reserve(clickLatencies.size() * 2);
+
+		decltype(m_estimatedLatencies) estimatedLatencies;
+		estimatedLatencies.swap(m_estimatedLatencies, estimatedLatencies);
+		m_estimatedLatencies.reserve(estimatedLatencies.size() * 2);
+
+		decltype(m_clickLatencyStats) clickLatencyStats;
+		clickLatencyStats.swap(m_clickLatencyStats, clickLatencyStats);
+		m_clickLatencyStats.reserve(clickLatencyStats.size() * 2);
+
+		decltype(m_newTargetNames) newTargetNames;
+		newTargetNames.swap(m_newTargetNames, newTargetNames);
+
 		// Unlock all the now-empty queues and write out our temporary copies
 		lk.unlock();
 
+		// Resolve newly registered target names (before writing the records that refer to them)
+		m_targetNames.append(newTargetNames);
+
 		recordFrameInfo(frameInfo);
 		recordPlayerActions(playerActions);
 		recordTargetLocations(targetLocations);
+		recordHardwareEvents(hardwareEvents);
+		recordClickLatencies(clickLatencies, "Click_Latencies");
+		recordClickLatencies(estimatedLatencies, "Estimated_Click_Latencies");
 
 		insertRowsIntoDB(m_db, "Questions", questions);
 		insertRowsIntoDB(m_db, "Targets", targets);
 		insertRowsIntoDB(m_db, "Users", users);
 		insertRowsIntoDB(m_db, "Trials", trials);
+		insertRowsIntoDB(m_db, "Render_Costs", renderCosts);
+		if (clickLatencyStats.size() > 0) insertRowsIntoDB(m_db, "Click_Latency_Stats", clickLatencyStats);
 
 		lk.lock();
 	}
@@ -558,6 +715,8 @@ void FPSciLogger::loggerThreadEntry()
 FPSciLogger::FPSciLogger(const String& filename, 
 	const String& subjectID, 
 	const String& expConfigFilename,
+	const String& expConfigHash,
+	const String& expDescription,
 	const shared_ptr<SessionConfig>& sessConfig, 
 	const String& description 
 	) : m_db(nullptr), m_config(sessConfig->logger)
@@ -567,7 +726,7 @@ FPSciLogger::FPSciLogger(const String& filename,
 	m_targetLocations.reserve(5000);
 	
 	// Create the results file
-	initResultsFile(filename, subjectID, expConfigFilename, sessConfig, description);
+	initResultsFile(filename, subjectID, expConfigFilename, expConfigHash, expDescription, sessConfig, description);
 
 	// Thread management
 	m_running = true;
@@ -4,6 +4,7 @@
 #include "UserConfig.h"
 #include "Session.h"
 #include "Dialogs.h"
+#include "EventLogger.h"
 
 using RowEntry = Array<String>;
 using Columns = Array<Array<String>>;
@@ -25,6 +26,8 @@ public:
 	using QuestionResult = RowEntry;
 	using TrialValues = RowEntry;
 	using UserValues = RowEntry;
+	using RenderCostValues = RowEntry;
+	using ClickLatencyStatValues = RowEntry;
 
 protected:
 	sqlite3* m_db = nullptr;						///< The db used for logging
@@ -47,6 +50,7 @@ protected:
 	std::condition_variable m_queueCV;
 
 	Array<String> m_trialParams;					///< Storage for trial parameters
+	Array<RowEntry> m_trialParamValues;				///< Logged parameter values for each trial (indexed as the session config's trials), resolved once per session
 
 	// Output queues for reported data storage
 	Array<FrameInfo> m_frameInfo;						///< Storage for frame info (sdt, idt, rdt)
@@ -56,6 +60,14 @@ protected:
 	Array<TargetInfo> m_targets;
 	Array<TrialValues> m_trials;						///< Trial ID, start/end time etc.
 	Array<UserValues> m_users;
+	Array<RenderCostValues> m_renderCosts;				///< Per-trial render pass timing
+	Array<HardwareEvent> m_hardwareEvents;				///< Events from the hardware event logger
+	Array<ClickLatency> m_clickLatencies;				///< Click-to-photon latencies from the hardware event logger
+	Array<ClickLatency> m_estimatedLatencies;			///< Click-to-present latencies estimated in software (per shot)
+	Array<ClickLatencyStatValues> m_clickLatencyStats;	///< Per-trial click-to-photon latency summaries
+	Array<String> m_newTargetNames;						///< Target names registered since the last write (in registry id order)
+
+	Array<String> m_targetNames = { "" };				///< Target names by registry id (only accessed by the logger thread, 0 is no target)
 
 	size_t getTotalQueueBytes()
 	{
@@ -63,8 +75,14 @@ protected:
 			queueBytes(m_playerActions) +
 			queueBytes(m_questions) +
 			queueBytes(m_targetLocations) +
+			queueBytes(m_newTargetNames) +
 			queueBytes(m_targets) +
-			queueBytes(m_trials);
+			queueBytes(m_trials) +
+			queueBytes(m_renderCosts) +
+			queueBytes(m_hardwareEvents) +
+			queueBytes(m_clickLatencies) +
+			queueBytes(m_estimatedLatencies) +
+			queueBytes(m_clickLatencyStats);
 	}
 
 	template<typename ItemType> void addToQueue(Array<ItemType>& queue, const ItemType& item)
@@ -92,10 +110,16 @@ protected:
 	/** Record an array of target locations */
 	void recordTargetLocations(const Array<TargetLocation>& locations);
 
+	/** Record events/latencies from the hardware event logger */
+	void recordHardwareEvents(const Array<HardwareEvent>& events);
+	void recordClickLatencies(const Array<ClickLatency>& latencies, const String& tableName);
+
 	/** Open a results file, or create it if it doesn't exist */
 	void initResultsFile(const String& filename, 
 		const String& subjectID, 
 		const String& expConfigFilename,
+		const String& expConfigHash,
+		const String& expDescription,
 		const shared_ptr<SessionConfig>& sessConfig, 
 		const String& description);
 
@@ -104,7 +128,7 @@ protected:
 
 	// Functions that set up the database schema
 	/** Create a session table with columns as specified by the provided sessionConfig */
-	void createExperimentsTable(const String& expConfigFilename);
+	void createExperimentsTable(const String& expConfigFilename, const String& expConfigHash, const String& expDescription);
 	void createSessionsTable(const Array<String>& sessParams);
 	void createTargetTypeTable();
 	void createTargetsTable();
@@ -115,6 +139,10 @@ protected:
 	void createFrameInfoTable();
 	void createQuestionsTable();
 	void createUsersTable();
+	void createRenderCostsTable();
+	void createEventsTable();
+	void createClickLatenciesTable(const String& tableName);
+	void createClickLatencyStatsTable();
 
 	// Functions that assume the schema from above
 	//void insertSession(sessionInfo);
@@ -123,28 +151,45 @@ protected:
 
 public:
 
-	FPSciLogger(const String& filename, const String& subjectID, const String& expConfigFilename, const shared_ptr<SessionConfig>& sessConfig, const String& description);
+	FPSciLogger(const String& filename, const String& subjectID, const String& expConfigFilename, const String& expConfigHash, const String& expDescription,
+		const shared_ptr<SessionConfig>& sessConfig, const String& description);
 	virtual ~FPSciLogger();
 	
 	static shared_ptr<FPSciLogger> create(const String& filename, 
 		const String& subjectID, 
 		const String& expConfigFilename,
+		const String& expConfigHash,
+		const String& expDescription,
 		const shared_ptr<SessionConfig>& sessConfig,
 		const String& description="None") 
 	{
-		return createShared<FPSciLogger>(filename, subjectID, expConfigFilename, sessConfig, description);
+		return createShared<FPSciLogger>(filename, subjectID, expConfigFilename, expConfigHash, expDescription, sessConfig, description);
 	}
 
 	void updateSessionEntry(bool complete, int taskCount, int trialCount);
 
 	void logFrameInfo(const FrameInfo& frameInfo) { addToQueue(m_frameInfo, frameInfo); }
+
+	/** Get the count of records waiting to be written to the database */
+	int queueDepth() {
+		std::lock_guard<std::mutex> lk(m_queueMutex);
+		return m_frameInfo.size() + m_playerActions.size() + m_questions.size() + m_targetLocations.size() + m_targets.size() + m_trials.size() + m_users.size() + m_renderCosts.size() + m_hardwareEvents.size() + m_clickLatencies.size() + m_estimatedLatencies.size() + m_clickLatencyStats.size() + m_newTargetNames.size();
+	}
 	void logPlayerAction(const PlayerAction& playerAction) { addToQueue(m_playerActions, playerAction); }
 	void logQuestionResult(const QuestionResult& questionResult) { addToQueue(m_questions, questionResult); }
 	void logTargetLocation(const TargetLocation& targetLocation) { addToQueue(m_targetLocations, targetLocation); }
+	/** Register the name for the next (session registry) target id, so records can carry the id instead of the name */
+	void logTargetName(const String& name) { addToQueue(m_newTargetNames, name); }
 	void logTargetInfo(const TargetInfo& targetInfo) { addToQueue(m_targets, targetInfo); }
 	void logTrial(const TrialValues& trial) { addToQueue(m_trials, trial); }
+	void logRenderCost(const RenderCostValues& cost) { addToQueue(m_renderCosts, cost); }
+	void logHardwareEvent(const HardwareEvent& event) { addToQueue(m_hardwareEvents, event); }
+	void logClickLatency(const ClickLatency& latency) { addToQueue(m_clickLatencies, latency); }
+	void logEstimatedLatency(const ClickLatency& latency) { addToQueue(m_estimatedLatencies, latency); }
+	void logClickLatencyStats(const ClickLatencyStatValues& stats) { addToQueue(m_clickLatencyStats, stats); }
 	
-	void addTrialParamValues(TrialValues& trial, const shared_ptr<TrialConfig>& config);
+	/** Append the (pre-resolved) logged parameter values for a trial (index into the session config's trials) */
+	void addTrialParamValues(TrialValues& trial, int trialIdx);
 	void logUserConfig(const UserConfig& userConfig, const String& sessId, const Vector2& sessTurnScale);
 	void logTargetTypes(const Array<shared_ptr<TargetConfig>>& targets);
 
@@ -0,0 +1,63 @@
+#include "MessageTemplate.h"
+
+static bool isVarChar(char c) {
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+MessageTemplate::MessageTemplate(const String& source, const Array<Var>& vars, const String& name, bool allowEnvVars) : m_source(source) {
+	const Array<String>& names = varNames();
+	Array<Segment> segments;
+	String literal;
+	size_t i = 0;
+	while (i < source.size()) {
+		const size_t delimIdx = source.find('%', i);
+		if (delimIdx == String::npos) {
+			literal.append(source.substr(i));
+			break;
+		}
+		literal.append(source.substr(i, delimIdx - i));
+
+		// Find the end of the token following the delimiter ('%' not followed by a letter, i.e. "50%", is literal text)
+		size_t end = delimIdx + 1;
+		while (end < source.size() && isVarChar(source[end])) { end++; }
+		if (end == delimIdx + 1 || !isalpha(source[delimIdx + 1]) || (allowEnvVars && end < source.size() && source[end] == '%')) {
+			literal.append(source.substr(delimIdx, end - delimIdx));
+			i = end;
+			continue;
+		}
+
+		// Match the longest supported variable name at the start of the token
+		const String token = source.substr(delimIdx + 1, end - delimIdx - 1);
+		Var match = Var::Literal;
+		size_t matchLength = 0;
+		for (Var var : vars) {
+			const String& varName = names[int(var)];
+			if (varName.size() > matchLength && beginsWith(token, varName)) {
+				match = var;
+				matchLength = varName.size();
+			}
+		}
+		if (match == Var::Literal) {
+			String supported;
+			for (Var var : vars) { supported += (supported.empty() ? "%" : ", %") + names[int(var)]; }
+			throw format("Unknown substring \"%%%s\" in \"%s\" (\"%s\")! Supported substrings are: %s", token.c_str(), name.c_str(), source.c_str(), supported.c_str());
+		}
+
+		if (!literal.empty()) {
+			segments.append(Segment{ Var::Literal, literal });
+			literal.clear();
+		}
+		segments.append(Segment{ match, "" });
+		i = delimIdx + 1 + matchLength;
+	}
+	if (!literal.empty()) segments.append(Segment{ Var::Literal, literal });
+	m_segments = std::make_shared<const Array<Segment>>(std::move(segments));
+}
+
+bool MessageTemplate::uses(Var var) const {
+	if (isNull(m_segments)) return false;
+	for (const Segment& segment : *m_segments) {
+		if (segment.var == var) return true;
+	}
+	return false;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <G3D/G3D.h>
+
+/** A feedback message or command string compiled (at config load) into literal segments and %variable references.
+	Rendering is then a single pass over the segments into a reusable output string, and values are only
+	computed for the variables a message actually uses. Unknown %variables are reported when compiling. */
+class MessageTemplate {
+public:
+	enum class Var {
+		Literal,							///< Not a variable (literal text)
+		// Feedback variables
+		TotalTimeLeftS,
+		LastBlock,
+		CurrBlock,
+		TotalBlocks,
+		TrialTaskTimeMs,
+		TrialTargetsDestroyed,
+		TrialTotalTargets,
+		TrialShotsHit,
+		TrialTotalShots,
+		SessionScore,
+		// Command variables
+		LoggerComPort,
+		LoggerSyncComPort,
+		DbFilename
+	};
+
+	/** Variable names (indexed by Var, without the leading '%') */
+	static const Array<String>& varNames() {
+		static const Array<String> names = { "", "totalTimeLeftS", "lastBlock", "currBlock", "totalBlocks", "trialTaskTimeMs", "trialTargetsDestroyed",
+			"trialTotalTargets", "trialShotsHit", "trialTotalShots", "sessionScore", "loggerComPort", "loggerSyncComPort", "dbFilename" };
+		return names;
+	}
+	/** Variables supported in feedback messages */
+	static const Array<Var>& feedbackVars() {
+		static const Array<Var> vars = { Var::TotalTimeLeftS, Var::LastBlock, Var::CurrBlock, Var::TotalBlocks, Var::TrialTaskTimeMs,
+			Var::TrialTargetsDestroyed, Var::TrialTotalTargets, Var::TrialShotsHit, Var::TrialTotalShots, Var::SessionScore };
+		return vars;
+	}
+	/** Variables supported in commands */
+	static const Array<Var>& commandVars() {
+		static const Array<Var> vars = { Var::LoggerComPort, Var::LoggerSyncComPort, Var::DbFilename };
+		return vars;
+	}
+
+	struct Segment {
+		Var		var = Var::Literal;
+		String	text;						///< Literal text (for Var::Literal segments)
+	};
+
+protected:
+	String								m_source;		///< Source string
+	shared_ptr<const Array<Segment>>	m_segments;		///< Compiled segments (immutable, so shared by copies)
+
+public:
+	MessageTemplate() {}
+	/** Compile a template using the given variables, throws naming the config field (name) if an unknown %variable is found.
+		When allowEnvVars is set, %NAME% (Windows environment variable) references are kept as literal text. */
+	MessageTemplate(const String& source, const Array<Var>& vars, const String& name, bool allowEnvVars = false);
+
+	const String& source() const { return m_source; }
+	bool empty() const { return m_source.empty(); }
+	bool uses(Var var) const;
+
+	/** Render into out (reusing its storage), appendValue(var, out) is called to append each variable's value */
+	template <class AppendValue>
+	void render(String& out, AppendValue appendValue) const {
+		out.clear();
+		if (isNull(m_segments)) return;
+		for (const Segment& segment : *m_segments) {
+			if (segment.var == Var::Literal) out.append(segment.text);
+			else appendValue(segment.var, out);
+		}
+	}
+};
@@ -0,0 +1,125 @@
+#include "PassTimer.h"
+
+void PassTimer::init() {
+	m_gpu = GLCaps::supports("GL_ARB_timer_query");
+	if (!m_gpu) {
+		logPrintf("GPU timer queries not supported, using CPU timing for render passes\n");
+	}
+}
+
+void PassTimer::cleanup() {
+	for (const String& name : m_names) {
+		PassTiming& pass = m_passes[name];
+		for (Query& query : pass.queries) {
+			if (query.start != 0) glDeleteQueries(1, &query.start);
+			if (query.end != 0) glDeleteQueries(1, &query.end);
+			query = Query();
+		}
+	}
+}
+
+void PassTimer::addSample(PassTiming& pass, float time) {
+	pass.lastTime = time;
+	if (pass.samples.size() < MAX_SAMPLES) pass.samples.append(time);
+}
+
+bool PassTimer::readQuery(PassTiming& pass, Query& query, bool wait) {
+	if (!wait) {
+		GLint available = 0;
+		glGetQueryObjectiv(query.end, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available) return false;
+	}
+	query.pending = false;
+
+	GLuint64 start = 0, end = 0;
+	glGetQueryObjectui64v(query.start, GL_QUERY_RESULT, &start);
+	glGetQueryObjectui64v(query.end, GL_QUERY_RESULT, &end);
+	if (query.generation == m_generation) addSample(pass, float(double(end - start) * 1e-9));
+	return true;
+}
+
+void PassTimer::beginFrame() {
+	m_frame++;
+	if (!m_gpu) return;
+
+	// Read back completed queries (oldest first, results complete in order so stop at the first unready query)
+	for (const String& name : m_names) {
+		PassTiming& pass = m_passes[name];
+		for (int i = 0; i < QUERY_SLOTS; i++) {
+			Query& query = pass.queries[(m_frame + i) % QUERY_SLOTS];
+			if (query.pending && !readQuery(pass, query, false)) break;
+		}
+	}
+}
+
+void PassTimer::finish() {
+	if (!m_gpu) return;
+	for (const String& name : m_names) {
+		PassTiming& pass = m_passes[name];
+		for (int i = 0; i < QUERY_SLOTS; i++) {
+			Query& query = pass.queries[(m_frame + i) % QUERY_SLOTS];
+			if (query.pending) readQuery(pass, query, true);
+		}
+	}
+}
+
+void PassTimer::begin(const String& name) {
+	bool created = false;
+	PassTiming& pass = m_passes.getCreate(name, created);
+	if (created) m_names.append(name);
+
+	if (m_gpu) {
+		Query& query = pass.queries[m_frame % QUERY_SLOTS];
+		if (query.start == 0) {
+			glGenQueries(1, &query.start);
+			glGenQueries(1, &query.end);
+		}
+		// The GPU is a full ring of frames behind, wait for this slot's result instead of losing it
+		if (query.pending) readQuery(pass, query, true);
+		query.generation = m_generation;
+		glQueryCounter(query.start, GL_TIMESTAMP);
+	}
+	else {
+		pass.cpuStart = System::time();
+	}
+}
+
+void PassTimer::end(const String& name) {
+	PassTiming* pass = m_passes.getPointer(name);
+	if (isNull(pass)) return;
+
+	if (m_gpu) {
+		Query& query = pass->queries[m_frame % QUERY_SLOTS];
+		glQueryCounter(query.end, GL_TIMESTAMP);
+		query.pending = true;
+	}
+	else {
+		addSample(*pass, float(System::time() - pass->cpuStart));
+	}
+}
+
+float PassTimer::lastTime(const String& name) const {
+	const PassTiming* pass = m_passes.getPointer(name);
+	return isNull(pass) ? 0.0f : pass->lastTime;
+}
+
+int PassTimer::sampleCount(const String& name) const {
+	const PassTiming* pass = m_passes.getPointer(name);
+	return isNull(pass) ? 0 : pass->samples.size();
+}
+
+float PassTimer::percentile(const String& name, float p) const {
+	const PassTiming* pass = m_passes.getPointer(name);
+	if (isNull(pass) || pass->samples.size() == 0) return 0.0f;
+	Array<float> sorted = pass->samples;
+	const int idx = clamp(iCeil(p * sorted.size()) - 1, 0, sorted.size() - 1);
+	std::nth_element(sorted.begin(), sorted.begin() + idx, sorted.end());
+	return sorted[idx];
+}
+
+void PassTimer::clearSamples() {
+	m_generation++;
+	for (const String& name : m_names) {
+		m_passes[name].samples.fastClear();
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <G3D/G3D.h>
+
+/** Times named render passes using GPU timestamp queries. Queries are held in a ring (per pass) and read back
+	once their results are available, so the CPU only waits on the GPU if it falls a full ring of frames behind.
+	Unready queries are kept (not dropped), so the slowest (GPU bound) frames are still counted.
+	When timer queries aren't supported (e.g. no GPU), passes are timed on the CPU instead. */
+class PassTimer {
+public:
+	static const int QUERY_SLOTS = 5;					///< Frames of queries that can be in flight (per pass)
+	static const int MAX_SAMPLES = 1 << 16;				///< Maximum samples held per pass (between calls to clearSamples())
+
+protected:
+	struct Query {
+		GLuint		start = 0;							///< Timestamp query at the start of the pass
+		GLuint		end = 0;							///< Timestamp query at the end of the pass
+		bool		pending = false;					///< Has this query been issued (and not yet read)?
+		int			generation = 0;						///< Sample generation the query was issued in (see clearSamples())
+	};
+
+	struct PassTiming {
+		Query		queries[QUERY_SLOTS];				///< Queries for the frames in flight
+		RealTime	cpuStart = 0.0;						///< CPU start time (for CPU timing)
+		float		lastTime = 0.0f;					///< Most recent time measured (in seconds)
+		Array<float> samples;							///< Times measured since the last clearSamples() (in seconds)
+	};
+
+	Table<String, PassTiming>	m_passes;				///< Timing for each pass
+	Array<String>				m_names;				///< Pass names (in the order they were first timed)
+	bool						m_gpu = false;			///< Are GPU timer queries used?
+	int							m_frame = 0;			///< Frame counter (selects the query slot)
+	int							m_generation = 0;		///< Incremented by clearSamples() (results of older queries are discarded)
+
+	void addSample(PassTiming& pass, float time);
+	/** Read a pending query into the samples, returns false if it isn't available (and wait is false) */
+	bool readQuery(PassTiming& pass, Query& query, bool wait);
+
+public:
+	/** Check for timer query support (requires a GL context) */
+	void init();
+	/** Delete all queries (requires a GL context) */
+	void cleanup();
+
+	/** Read back the results of any (completed) queries, call once per frame before timing any passes */
+	void beginFrame();
+	/** Wait for and read back all queries in flight (i.e. before reporting the samples) */
+	void finish();
+	void begin(const String& pass);
+	void end(const String& pass);
+
+	/** Are times measured on the GPU (otherwise CPU timing is used)? */
+	bool gpuTiming() const { return m_gpu; }
+	const Array<String>& passNames() const { return m_names; }
+	/** Most recent time measured for a pass (in seconds) */
+	float lastTime(const String& pass) const;
+
+	/** Count of samples recorded for a pass since the last clearSamples() */
+	int sampleCount(const String& pass) const;
+	/** Get the time (in seconds) at a given percentile (0-1) of the samples recorded since the last clearSamples() */
+	float percentile(const String& pass, float p) const;
+	/** Clear the samples, results of queries still in flight are discarded */
+	void clearSamples();
+};
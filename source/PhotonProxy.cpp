@@ -0,0 +1,72 @@
+#include "PhotonProxy.h"
+
+#ifdef _WIN32
+#include <dwmapi.h>
+#pragma comment(lib, "dwmapi.lib")
+
+/** Present clock using the compositor (DWM) vblank timing */
+class CompositorClock : public PhotonProxy::PresentClock {
+public:
+	bool lastPresentTime(RealTime& time) override {
+		DWM_TIMING_INFO info = {};
+		info.cbSize = sizeof(info);
+		if (FAILED(DwmGetCompositionTimingInfo(NULL, &info))) return false;
+		// Convert the vblank (QPC) time onto the System::time() clock
+		LARGE_INTEGER now, frequency;
+		QueryPerformanceCounter(&now);
+		QueryPerformanceFrequency(&frequency);
+		time = System::time() - double(now.QuadPart - LONGLONG(info.qpcVBlank)) / double(frequency.QuadPart);
+		return true;
+	}
+};
+#endif
+
+shared_ptr<PhotonProxy::PresentClock> PhotonProxy::compositorClock() {
+#ifdef _WIN32
+	BOOL enabled = FALSE;
+	if (SUCCEEDED(DwmIsCompositionEnabled(&enabled)) && enabled) {
+		return std::make_shared<CompositorClock>();
+	}
+#endif
+	return nullptr;
+}
+
+void PhotonProxy::onShot(int frame) {
+	if (!m_inputPending) return;		// Only shots caused by an input are tracked (i.e. not the later shots of automatic fire)
+	m_inputPending = false;
+
+	if (m_pending.size() >= MAX_PENDING) m_pending.remove(0);
+	Estimate shot;
+	shot.inputTicks = m_inputTicks;
+	shot.frame = frame;
+	shot.input = m_inputTime;
+	shot.submit = -1.0;
+	m_pending.append(shot);
+}
+
+void PhotonProxy::onSubmit(int frame, RealTime time, float addedLatency) {
+	// Mark shots in this (or earlier) frames as submitted
+	for (Estimate& shot : m_pending) {
+		if (shot.submit < 0.0 && shot.frame <= frame) shot.submit = time + addedLatency;
+	}
+
+	RealTime present = 0.0;
+	const bool hasPresent = notNull(m_clock) && m_clock->lastPresentTime(present);
+
+	// Complete shots once their frame has been presented (or the present clock has stopped advancing)
+	for (int i = 0; i < m_pending.size(); i++) {
+		Estimate& shot = m_pending[i];
+		if (shot.submit < 0.0) continue;
+		if (hasPresent && present >= shot.submit) {
+			shot.present = present;
+			shot.presented = true;
+		}
+		else if (!hasPresent || time - shot.submit > MAX_PRESENT_WAIT_S) {
+			shot.present = shot.submit;
+			shot.presented = false;
+		}
+		else continue;
+		m_complete.append(shot);
+		m_pending.remove(i--);
+	}
+}
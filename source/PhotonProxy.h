@@ -0,0 +1,77 @@
+#pragma once
+
+#include <G3D/G3D.h>
+
+/** Software estimate of click-to-photon latency (for systems without the hardware event logger).
+	Each shot's pipeline is tracked from the input event that caused it, through the simulation frame that consumed the input and
+	the time that frame was submitted, to the time it was presented (when a present clock, i.e. the compositor, is available).
+	Without a present clock the submit time is used as the (lower bound) present time. */
+class PhotonProxy {
+public:
+	/** Source of present timestamps (on the System::time() clock) */
+	class PresentClock {
+	public:
+		virtual ~PresentClock() {}
+		/** Get the time of the most recent present (i.e. compositor vblank), returns false if not available */
+		virtual bool lastPresentTime(RealTime& time) = 0;
+	};
+
+	/** Get a present clock from the compositor (returns nullptr if composition timing isn't available) */
+	static shared_ptr<PresentClock> compositorClock();
+
+	/** A completed estimate for a single shot */
+	struct Estimate {
+		uint64		inputTicks = 0;				///< Time of the input (FILETIME ticks, for logging)
+		int			frame = 0;					///< Frame that consumed the input
+		RealTime	input = 0.0;				///< Time of the input event
+		RealTime	submit = 0.0;				///< Time the shot's frame was submitted (plus any added display latency)
+		RealTime	present = 0.0;				///< Time the shot's frame was presented (equal to submit when not available)
+		bool		presented = false;			///< Was the present time measured (otherwise submit time is used)?
+
+		float latencyMs() const { return float(1000.0 * (present - input)); }
+		String mode() const { return presented ? "present" : "submit"; }
+	};
+
+	static const int MAX_PENDING = 64;						///< Maximum shots waiting on submit/present (oldest are dropped)
+	static constexpr RealTime MAX_PRESENT_WAIT_S = 0.25;	///< Maximum time to wait for a present before falling back to the submit time
+
+protected:
+	shared_ptr<PresentClock>	m_clock;					///< Present clock (nullptr to use submit times)
+	bool						m_inputPending = false;		///< Is an input waiting to be consumed by a shot?
+	RealTime					m_inputTime = 0.0;			///< Time of the pending input
+	uint64						m_inputTicks = 0;			///< Time of the pending input (for logging)
+	Array<Estimate>				m_pending;					///< Shots waiting on submit/present (submit < 0 until submitted)
+	Array<Estimate>				m_complete;					///< Completed estimates (since the last takeEstimates())
+
+public:
+	void setPresentClock(const shared_ptr<PresentClock>& clock) { m_clock = clock; }
+	bool hasPresentClock() const { return notNull(m_clock); }
+
+	/** Record a fire input (only the first input before a shot is kept) */
+	void onInput(RealTime time, uint64 ticks) {
+		if (m_inputPending) return;
+		m_inputPending = true;
+		m_inputTime = time;
+		m_inputTicks = ticks;
+	}
+	/** Drop any input that wasn't consumed by a shot (called at the end of each simulation step) */
+	void clearInput() { m_inputPending = false; }
+
+	/** A shot was fired in this frame (consuming the pending input, if any) */
+	void onShot(int frame);
+	/** A frame was submitted at this time (addedLatency is display latency added after submit, i.e. delay buffers) */
+	void onSubmit(int frame, RealTime time, float addedLatency = 0.0f);
+
+	/** Move completed estimates into the output array */
+	void takeEstimates(Array<Estimate>& estimates) {
+		estimates.fastClear();
+		estimates.swap(m_complete, estimates);
+	}
+
+	int pendingCount() const { return m_pending.size(); }
+	void clear() {
+		m_inputPending = false;
+		m_pending.fastClear();
+		m_complete.fastClear();
+	}
+};
@@ -1,6 +1,10 @@
 #include "PhysicsScene.h"
 #include "PlayerEntity.h"
 #include "FPSciAnyTableReader.h"
+#include <fstream>
+
+Array<PhysicsScene::CachedCollisionTree> PhysicsScene::s_collisionTreeCache;
+std::thread PhysicsScene::s_prefetchThread;
 
 shared_ptr<PhysicsScene> PhysicsScene::create(const shared_ptr<AmbientOcclusion>& ao) {
     return createShared<PhysicsScene>(ao);
@@ -24,6 +28,7 @@ Any PhysicsScene::toAny() const {
 }
 
 Any PhysicsScene::load(const String& sceneName, const LoadOptions& loadOptions) {
+    waitForPrefetch();          // Don't compete with the prefetch thread for the disk
     Any resultAny = Scene::load(sceneName, loadOptions);
 	Vector3 m_gravity(0, -5 * units::meters() / square(units::seconds()), 0);
 
@@ -34,6 +39,13 @@ Any PhysicsScene::load(const String& sceneName, const LoadOptions& loadOptions)
 		physicsTable.getIfPresent("minHeight", m_resetHeight);
     }
     
+    // Reuse the collision tree if this scene has been loaded before
+    int cacheIdx = -1;
+    for (int i = 0; i < s_collisionTreeCache.size(); i++) {
+        if (s_collisionTreeCache[i].sceneName == sceneName) { cacheIdx = i; break; }
+    }
+    const bool cached = cacheIdx >= 0;
+
     // Set the initial positions
 	float minHeight = 1e6;
     Array<shared_ptr<Surface>> collisionSurfaces;
@@ -42,11 +54,22 @@ Any PhysicsScene::load(const String& sceneName, const LoadOptions& loadOptions)
 		if (notNull(entity)) {
 			if (!entity->canChange()) {
 				entity->onSimulation(0, 0);
-				entity->onPose(collisionSurfaces);
+				if (!cached) entity->onPose(collisionSurfaces);
 			}
 		}
     }
-    m_collisionTree->setContents(collisionSurfaces, IMAGE_STORAGE_CURRENT);
+
+    if (cached) {
+        m_collisionTree = s_collisionTreeCache[cacheIdx].tree;
+        s_collisionTreeCache.remove(cacheIdx);
+    }
+    else {
+        // Create a new tree here (the previous one may be held by the cache)
+        m_collisionTree = TriTree::create(false);
+        m_collisionTree->setContents(collisionSurfaces, IMAGE_STORAGE_CURRENT);
+        if (s_collisionTreeCache.size() >= MAX_CACHED_COLLISION_TREES) s_collisionTreeCache.pop();    // Evict the least recently used tree
+    }
+    s_collisionTreeCache.insert(0, CachedCollisionTree{ sceneName, m_collisionTree });
     return resultAny;
 }
 
@@ -62,3 +85,43 @@ void PhysicsScene::staticIntersectBox(const AABox& box, Array<Tri>& triArray) co
     }
 }
 
+
+void PhysicsScene::prefetch(const String& sceneName) {
+    waitForPrefetch();
+    // Resolve the scene and model filenames on the calling thread (G3D's FileSystem and data file lookups aren't thread-safe)
+    const String sceneFilename = sceneNameToFilename(sceneName);
+    if (sceneFilename.empty()) return;
+    Array<String> filenames;
+    try {
+        Any sceneAny;
+        sceneAny.load(sceneFilename);
+        if (sceneAny.containsKey("models")) {
+            const String sceneDir = FilePath::parent(sceneFilename);
+            for (Table<String, Any>::Iterator it = sceneAny["models"].table().begin(); it.isValid(); ++it) {
+                const Any& spec = it->value;
+                if (spec.type() != Any::TABLE || !spec.containsKey("filename")) continue;
+                String modelFilename = spec["filename"].string();
+                if (!FileSystem::exists(modelFilename)) modelFilename = FilePath::concat(sceneDir, modelFilename);
+                if (FileSystem::exists(modelFilename)) filenames.append(FileSystem::resolve(modelFilename));
+            }
+        }
+    }
+    catch (...) {
+        // Prefetching is best-effort, any real errors are reported by the load itself
+    }
+    if (filenames.size() > 0) s_prefetchThread = std::thread(&PhysicsScene::prefetchFiles, filenames);
+}
+
+void PhysicsScene::waitForPrefetch() {
+    if (s_prefetchThread.joinable()) s_prefetchThread.join();
+}
+
+void PhysicsScene::prefetchFiles(const Array<String>& filenames) {
+    // Read each model file once so the OS has it cached when the scene is loaded
+    static const int CHUNK_BYTES = 1 << 20;
+    std::unique_ptr<char[]> chunk(new char[CHUNK_BYTES]);
+    for (const String& filename : filenames) {
+        std::ifstream file(filename.c_str(), std::ios::binary);
+        while (file.read(chunk.get(), CHUNK_BYTES)) {}
+    }
+}
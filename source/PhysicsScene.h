@@ -9,6 +9,20 @@ protected:
     /** Polygons of all non-dynamic entitys */
     shared_ptr<TriTree>                     m_collisionTree;
 
+    /** A collision tree built for a previously loaded scene */
+    struct CachedCollisionTree {
+        String              sceneName;      ///< The tree only depends on the scene's static geometry, so it is keyed by scene name
+        shared_ptr<TriTree> tree;
+    };
+    /** Most recently used collision trees (shared across sessions, most recent first) */
+    static Array<CachedCollisionTree>       s_collisionTreeCache;
+    static const int                        MAX_CACHED_COLLISION_TREES = 2;   ///< Enough to switch back and forth between sessions' scenes
+    /** Background thread used to prefetch scene files from disk */
+    static std::thread                      s_prefetchThread;
+
+    /** Read the given (already resolved) files with the standard library, run on the prefetch thread so it never uses G3D's (non thread-safe) FileSystem */
+    static void prefetchFiles(const Array<String>& filenames);
+
     PhysicsScene(const shared_ptr<AmbientOcclusion>& ao) : Scene(ao) {
         m_collisionTree = TriTree::create(false);
     }
@@ -25,6 +39,15 @@ public:
 	float resetHeight() { return m_resetHeight; }
     Vector3 gravity() const { return m_gravity; }
 
+    /** Drop all cached collision trees (e.g. when scene files may have changed on disk) */
+    static void clearCache() { s_collisionTreeCache.clear(); }
+
+    /** Start reading the files for a scene in the background so a later load() doesn't stall on disk */
+    static void prefetch(const String& sceneName);
+
+    /** Block until any outstanding prefetch has finished */
+    static void waitForPrefetch();
+
     /** Extend to read in physics properties */
     virtual Any load(const String& sceneName, const LoadOptions& loadOptions = LoadOptions()) override;
 
@@ -193,7 +193,7 @@ int SessionConfig::getTrialIndex(const String& id) const {
 
 Array<String> SessionConfig::getUniqueTargetIds() const {
 	Array<String> targetIds;
-	for (TrialConfig trial : trials) {
+	for (const TrialConfig& trial : trials) {
 		for (String id : trial.targetIds) {
 			if (!targetIds.contains(id)) { targetIds.append(id); }
 		}
@@ -209,27 +209,23 @@ Session::Session(FPSciApp* app) : m_app(app), m_weapon(app->weapon) {
 	m_hasSession = false;
 }
 
+Session::~Session() {
+	clearTargets();					// Clear the targets when the session is done
+	if (m_targetPool.hits() + m_targetPool.misses() > 0) {
+		logPrintf("Target pool: reused %d targets, created %d targets\n", m_targetPool.hits(), m_targetPool.misses());
+	}
+	// For now leave "orphaned" processes to allow (session) end commands to run until completion
+	//closeTrialProcesses();		// Close any trial processes affiliated with this session
+	//closeSessionProcesses();		// Close any processes affiliated with this session
+}
+
 const RealTime Session::targetFrameTime()
 {
 	const RealTime defaultFrameTime = 1.0 / m_app->window()->settings().refreshRate;
 	if (!m_hasSession) return defaultFrameTime;
 
-	uint arraySize = m_trialConfig->render.frameTimeArray.size();
-	if (arraySize > 0) {
-		if ((m_trialConfig->render.frameTimeMode == "taskonly" || m_trialConfig->render.frameTimeMode == "restartwithtask") && currentState != PresentationState::trialTask) {
-			// We are in a frame time mode which specifies only to change frame time during the task
-			return 1.0f / m_trialConfig->render.frameRate;
-		}
-
-		if (m_trialConfig->render.frameTimeRandomize) {
-			return m_trialConfig->render.frameTimeArray.randomElement();
-		}
-		else {
-			RealTime targetTime = m_trialConfig->render.frameTimeArray[m_frameTimeIdx % arraySize];
-			m_frameTimeIdx += 1;
-			m_frameTimeIdx %= arraySize;
-			return targetTime;
-		}
+	if (m_frameTimeSchedule.active()) {
+		return m_frameTimeSchedule.next(currentState == PresentationState::trialTask);
 	}
 
 	// The below matches the functionality in FPSciApp::updateParameters()
@@ -242,36 +238,11 @@ const RealTime Session::targetFrameTime()
 bool Session::nextTrial() {
 	// Do we need to create a new task?
 	if(m_taskTrials.length() == 0) {
-		// Build an array of unrun tasks in this block
-		Array<Array<int>> unrunTaskIdxs;
-		for (int i = 0; i < m_remainingTasks.size(); i++) {
-			for (int j = 0; j < m_remainingTasks[i].size(); j++) {
-				if (m_remainingTasks[i][j] > 0 || m_remainingTasks[i][j] == -1) {
-					if (m_sessConfig->randomizeTaskOrder && m_sessConfig->weightByCount) {
-						// Weight by remaining count of this trial type
-						for (int k = 0; k < m_remainingTasks[i][j]; k++) {
-							unrunTaskIdxs.append(Array<int>(i,j));  			// Add proportional to the # of times this task needs to be run
-						}
-					}
-					else {
-						// Add a single instance for each trial that is unrun (don't weight by remaining count)
-						unrunTaskIdxs.append(Array<int>(i,j));
-					}
-				}
-			}
-		}
-		if (unrunTaskIdxs.size() == 0) return false;		// If there are no remaining tasks return
+		// Pick the new task and trial order index (randomly when randomizing task order, or trial order when trials are treated as tasks)
+		if (!m_tasks.next(m_sessConfig->randomizeTaskOrder, m_currTaskIdx, m_currOrderIdx)) return false;		// If there are no remaining tasks return
 
-		// Pick the new task and trial order index
-		int idx = 0;
-		// Are we randomizing task order (or randomizing trial order when trials are treated as tasks)?
-		if (m_sessConfig->randomizeTaskOrder) {				
-			idx = Random::common().integer(0, unrunTaskIdxs.size() - 1);		// Pick a random trial from within the array
-		}
-		m_currTaskIdx = unrunTaskIdxs[idx][0];
-		m_currOrderIdx = unrunTaskIdxs[idx][1];
-		
 		m_completedTaskTrials.clear();
+		m_completedTaskTrialCount = 0;
 		// Populate the task trial and completed task trials array
 		Array<String> trialIds;
 		String taskId;
@@ -298,6 +269,9 @@ bool Session::nextTrial() {
 
 	// Get and update the trial configuration
 	m_trialConfig = TrialConfig::createShared<TrialConfig>(m_sessConfig->trials[m_currTrialIdx]);
+	// Compile the frame time schedule for this trial (frame time used outside of the task matches targetFrameTime())
+	const float baseFrameTime = m_trialConfig->render.frameRate > 0 ? 1.0f / m_trialConfig->render.frameRate : 1.0f / m_app->window()->settings().refreshRate;
+	m_frameTimeSchedule.compile(m_trialConfig->render, baseFrameTime);
 	// Respawn player for first trial in session (override session-level spawn position)
 	m_app->updateTrial(m_trialConfig, false, m_firstTrial);	
 	if (m_firstTrial) m_firstTrial = false;
@@ -318,53 +292,24 @@ bool Session::nextTrial() {
 }
 
 int Session::getTaskCount(const int currTaskIdx) const {
-	int idx = 0;
-	for (int trialOrderCount : m_completedTasks[currTaskIdx]) {
-		idx += trialOrderCount;
-	}
-	return idx;
+	return m_tasks.taskCompleted(currTaskIdx);
 }
 
 bool Session::blockComplete() const {
-	for (Array<int> trialOrders : m_remainingTasks) {
-		for (int remaining : trialOrders) {
-			if (remaining != 0) return false;		// If any trials still need to be run block isn't complete
-		}
-	}
-	return true;		// Block is complete
+	return m_tasks.blockComplete();
 }
 
 bool Session::nextBlock(bool init) {
-	if (m_sessConfig->tasks.size() == 0) {									// If there are no tasks make each trial its own task
-		for (int i = 0; i < m_targetConfigs.size(); i++) {					// There is 1 trial per task, and 1 set of targets specified per trial in the target configs array
-			if (init) { // If this is the first block in the session
-				m_completedTasks.append(Array<int>(0));
-				m_remainingTasks.append(Array<int>(m_sessConfig->trials[i].count));
-			}
-			else { // Update for a new block in the session
-				m_completedTasks[i][0] = 0;
-				m_remainingTasks[i][0] += m_trialConfig->count;		// Add another set of trials of this type
-			}
+	if (init) {
+		m_tasks.clear(m_sessConfig->weightByCount);
+		if (m_sessConfig->tasks.size() == 0) {								// If there are no tasks make each trial its own task (with a single trial order)
+			for (const TrialConfig& trial : m_sessConfig->trials) { m_tasks.addTask(1, trial.count); }
 		}
-	}
-	else {
-		for (int i = 0; i < m_sessConfig->tasks.size(); i++) {
-			if (init) {
-				m_completedTasks.append(Array<int>());		// Initialize task-level completed trial orders array
-				m_remainingTasks.append(Array<int>());		// Initialize task-level remaining trial orders array
-			}
-			for (int j = 0; j < m_sessConfig->tasks[i].trialOrders.size(); j++) {
-				if (init) {
-					m_completedTasks[i].append(0);	// Zero completed count
-					m_remainingTasks[i].append(m_sessConfig->tasks[i].count); // Append to complete count
-				}
-				else {
-					m_completedTasks[i][j] = 0;
-					m_remainingTasks[i][j] += m_sessConfig->tasks[i].count;
-				}
-			}
+		else {
+			for (const TaskConfig& task : m_sessConfig->tasks) { m_tasks.addTask(task.trialOrders.size(), task.count); }
 		}
 	}
+	m_tasks.startBlock();			// Add another set of each task/trial order to the remaining counts
 	return nextTrial();
 }
 
@@ -372,14 +317,13 @@ void Session::onInit(String filename, String description) {
 	// Initialize presentation states
 	currentState = PresentationState::initial;
 	if (m_sessConfig) {
-		m_feedbackMessage = formatFeedback(m_sessConfig->targetView.showRefTarget ? m_sessConfig->feedback.initialWithRef: m_sessConfig->feedback.initialNoRef);
+		m_feedbackMessage = formatFeedback(m_sessConfig->targetView.showRefTarget ? m_sessConfig->feedback.initialWithRefMsg : m_sessConfig->feedback.initialNoRefMsg);
 	}
 
 	// Get the player from the app
 	m_player = m_app->scene()->typedEntity<PlayerEntity>("player");
 	m_scene = m_app->scene().get();
 	m_camera = m_app->activeCamera();
-	m_targetModels = &(m_app->targetModels);
 
 	// Check for valid session
 	if (m_hasSession) {
@@ -388,6 +332,7 @@ void Session::onInit(String filename, String description) {
 			// Setup the logger and create results file
 			logger = FPSciLogger::create(filename + ".db", user.id, 
 				m_app->startupConfig.experimentList[m_app->experimentIdx].experimentConfigFilename, 
+				m_app->experimentConfigHash(), m_app->experimentConfig.description,
 				m_sessConfig, description);
 			logger->logTargetTypes(m_app->experimentConfig.getSessionTargets(m_sessConfig->id));			// Log target info at start of session
 			logger->logUserConfig(user, m_sessConfig->id, m_sessConfig->player.turnScale);					// Log user info at start of session
@@ -409,7 +354,7 @@ void Session::randomizePosition(const shared_ptr<TargetEntity>& target) const {
 	static const Point3 initialSpawnPos = m_camera->frame().translation;
 	const int trialIdx = m_sessConfig->getTrialIndex(m_trialConfig->id);
 	shared_ptr<TargetConfig> config = m_targetConfigs[trialIdx][target->paramIdx()];
-	const bool isWorldSpace = config->destSpace == "world";
+	const bool isWorldSpace = config->destSpace == TargetConfig::DestSpace::World;
 	Point3 loc;
 
 	if (isWorldSpace) {
@@ -441,7 +386,14 @@ void Session::initTargetAnimation(const bool task) {
 			}
 		}
 		else {
-			spawnTrialTargets(initialSpawnPos);			// Spawn all the targets normally
+			if (m_prefetchedTargets.size() > 0 && m_prefetchSpawnPos == initialSpawnPos) {
+				insertTrialTargets(m_prefetchedTargets, false, m_taskStartTime);		// Use the targets prepared during pretrial
+			}
+			else {
+				for (const PreparedTarget& prepared : m_prefetchedTargets) { m_targetPool.release(prepared.entity); }
+				m_prefetchedTargets.fastClear();		// The player moved since the targets were prepared
+				spawnTrialTargets(initialSpawnPos);		// Spawn all the targets normally
+			}
 			m_weapon->drawsDecals = true;				// Enable drawing decals
 		}
 	}
@@ -463,9 +415,6 @@ void Session::initTargetAnimation(const bool task) {
 
 		// Set weapon decal state to match configuration for reference targets
 		m_weapon->drawsDecals = m_trialConfig->targetView.showRefDecals;
-	
-		// Clear target logOnChange management
-		m_lastLogTargetLoc.clear();
 	}
 
 	// Reset number of destroyed targets (in the trial)
@@ -476,22 +425,23 @@ void Session::initTargetAnimation(const bool task) {
 }
 
 void Session::spawnTrialTargets(Point3 initialSpawnPos, bool previewMode) {
+	Array<PreparedTarget> targets;
+	prepareTrialTargets(initialSpawnPos, previewMode, targets);
+	insertTrialTargets(targets, previewMode, FPSciLogger::genUniqueTimestamp());
+}
+
+void Session::prepareTrialTargets(Point3 initialSpawnPos, bool previewMode, Array<PreparedTarget>& targets) {
+	targets.fastClear();
 	// Iterate through the targets
 	for (int i = 0; i < m_targetConfigs[m_currTrialIdx].size(); i++) {
 		const Color3 previewColor = m_trialConfig->targetView.previewColor;
 		shared_ptr<TargetConfig> target = m_targetConfigs[m_currTrialIdx][i];
-		const String name = format("%s_%d_%d_%d_%s_%d", m_sessConfig->id, m_currTaskIdx, m_currOrderIdx, m_completedTasks[m_currTaskIdx][m_currOrderIdx], target->id, i);
+		const String name = format("%s_%d_%d_%d_%s_%d", m_sessConfig->id, m_currTaskIdx, m_currOrderIdx, m_tasks.completed(m_currTaskIdx, m_currOrderIdx), target->id, i);
 
 		const float spawn_eccV = (target->symmetricEccV ? randSign() : 1) * Random::common().uniform(target->eccV[0], target->eccV[1]);
 		const float spawn_eccH = (target->symmetricEccH ? randSign() : 1) * Random::common().uniform(target->eccH[0], target->eccH[1]);
 		const float targetSize = G3D::Random().common().uniform(target->size[0], target->size[1]);
-		bool isWorldSpace = target->destSpace == "world";
-
-		// Log the target if desired
-		if (m_sessConfig->logger.enable) {
-			const String spawnTime = FPSciLogger::genUniqueTimestamp();
-			logger->addTarget(name, target, spawnTime, targetSize, Point2(spawn_eccH, spawn_eccV));
-		}
+		bool isWorldSpace = target->destSpace == TargetConfig::DestSpace::World;
 
 		CFrame f = CFrame::fromXYZYPRDegrees(initialSpawnPos.x, initialSpawnPos.y, initialSpawnPos.z, -initialHeadingRadians * 180.0f / pif() - spawn_eccH, spawn_eccV, 0.0f);
 
@@ -515,8 +465,28 @@ void Session::spawnTrialTargets(Point3 initialSpawnPos, bool previewMode) {
 
 		// Set whether the target can be hit based on whether we are in preview mode
 		t->setCanHit(!previewMode);
-		previewMode ? m_unhittableTargets.append(t) : m_hittableTargets.append(t);
+		targets.append(PreparedTarget{ t, target, name, targetSize, Point2(spawn_eccH, spawn_eccV) });
+	}
+}
+
+void Session::insertTrialTargets(Array<PreparedTarget>& targets, bool previewMode, const String& spawnTime) {
+	for (const PreparedTarget& prepared : targets) {
+		// Log the target if desired
+		if (m_sessConfig->logger.enable) {
+			logger->addTarget(prepared.name, prepared.config, spawnTime, prepared.size, prepared.eccentricity);
+		}
+		insertTarget(prepared.entity);
+		previewMode ? m_unhittableTargets.append(prepared.entity) : m_hittableTargets.append(prepared.entity);
 	}
+	targets.fastClear();
+}
+
+void Session::prefetchTrialTargets() {
+	m_prefetchedTargets.fastClear();
+	// Preview targets are already in the scene (and are activated at the start of the task)
+	if (m_trialConfig->targetView.previewWithRef && m_trialConfig->targetView.showRefTarget) return;
+	m_prefetchSpawnPos = m_player->getCameraFrame().translation;
+	prepareTrialTargets(m_prefetchSpawnPos, false, m_prefetchedTargets);
 }
 
 void Session::processResponse() {
@@ -524,47 +494,30 @@ void Session::processResponse() {
 
 	const int totalTargets = totalTrialTargets();
 	recordTrialResponse(m_destroyedTargets, totalTargets);				// Record the trial response into the database
+	recordRenderCosts();												// Record (and reset) the render pass timing for this trial
+	recordClickLatencyStats();											// Record the click-to-photon latency for this trial
 
 	// Update completed/remaining task state
 	if (m_taskTrials.size() == 0) {										// Task is complete update tracking
-		m_completedTasks[m_currTaskIdx][m_currOrderIdx] += 1;			// Mark task trial order as completed
-		if (m_remainingTasks[m_currTaskIdx][m_currOrderIdx] > 0) {		// Remove task trial order from remaining
-			m_remainingTasks[m_currTaskIdx][m_currOrderIdx] -= 1;
-		}
+		m_tasks.complete(m_currTaskIdx, m_currOrderIdx);				// Mark task trial order as completed (and remove it from remaining)
 	}
 	m_completedTaskTrials[m_trialConfig->id] += 1;						// Incrememnt count of this trial type in task
+	m_completedTaskTrialCount += 1;
 
 	// This update is only used for completed trials
 	if (notNull(logger)) {
-		// Get completed task and trial count
-		int completeTrials = 0;
-		int completeTasks = 0;
-		for (int i = 0; i < m_completedTasks.length(); i++) {
-			for (int count : m_completedTasks[i]) { 
-				completeTrials += count;	
-			}
-			bool taskComplete = true;
-			for (int remaining : m_remainingTasks[i]) {
-				if (remaining > 0) {
-					taskComplete = false;
-					break;
-				}
-			}
-			if (taskComplete) { completeTasks += 1; }
-		}
-
-		// Update session entry in database
-		logger->updateSessionEntry(m_currBlock > m_sessConfig->blockCount, completeTasks, completeTrials);			
+		// Update session entry in database (with the completed task and trial count)
+		logger->updateSessionEntry(m_currBlock > m_sessConfig->blockCount, m_tasks.completeTasks(), m_tasks.completedTotal());
 	}
 
 	// Check for whether all targets have been destroyed
 	if (m_destroyedTargets == totalTargets) {
 		m_totalRemainingTime += (double(m_trialConfig->timing.maxTrialDuration) - m_taskExecutionTime);
-		m_feedbackMessage = formatFeedback(m_trialConfig->feedback.trialSuccess);
+		m_feedbackMessage = formatFeedback(m_trialConfig->feedback.trialSuccessMsg);
 		m_totalTrialSuccesses += 1;
 	}
 	else {
-		m_feedbackMessage = formatFeedback(m_trialConfig->feedback.trialFailure);
+		m_feedbackMessage = formatFeedback(m_trialConfig->feedback.trialFailureMsg);
 	}
 }
 
@@ -611,6 +564,9 @@ void Session::updatePresentationState() {
 		if ((stateElapsedTime > m_trialConfig->timing.maxTrialDuration) || (remainingTargets <= 0) || (m_weapon->remainingAmmo() == 0))
 		{
 			m_taskEndTime = FPSciLogger::genUniqueTimestamp();
+			if (notNull(m_app->eventLogger())) {
+				m_app->eventLogger()->stats().endTrial();		// Stop collecting click-to-photon latency (feedback clicks aren't part of the trial)
+			}
 			processResponse();
 			clearTargets(); // clear all remaining targets
 			newState = PresentationState::trialFeedback;
@@ -662,8 +618,8 @@ void Session::updatePresentationState() {
 					// Update the success value if a valid question was asked and correctAnswer was given
 					success = m_sessConfig->tasks[m_currTaskIdx].questions[qIdx].result == m_sessConfig->tasks[m_currTaskIdx].trialOrders[m_currOrderIdx].correctAnswer;
 				}
-				if (success) m_feedbackMessage = formatFeedback(m_sessConfig->feedback.taskSuccess);
-				else m_feedbackMessage = formatFeedback(m_sessConfig->feedback.taskFailure);
+				if (success) m_feedbackMessage = formatFeedback(m_sessConfig->feedback.taskSuccessMsg);
+				else m_feedbackMessage = formatFeedback(m_sessConfig->feedback.taskFailureMsg);
 			}
 			newState = PresentationState::taskFeedback;
 		}
@@ -680,7 +636,7 @@ void Session::updatePresentationState() {
 					newState = PresentationState::sessionFeedback;
 				}
 				else {	// Block is complete but session isn't
-					m_feedbackMessage = formatFeedback(m_sessConfig->feedback.blockComplete);
+					m_feedbackMessage = formatFeedback(m_sessConfig->feedback.blockCompleteMsg);
 					nextBlock();
 					newState = PresentationState::initial;
 				}
@@ -699,29 +655,14 @@ void Session::updatePresentationState() {
 				if (allAnswered) {			// Present questions until done here
 					// Write final session timestamp to log
 					if (notNull(logger) && m_sessConfig->logger.enable) {
-						int completeTrials = 0;
-						int completeTasks = 0;
-						for (int i = 0; i < m_completedTasks.length(); i++) {
-							for (int count : m_completedTasks[i]) {
-								completeTrials += count;
-							}
-							bool taskComplete = true;
-							for (int remaining : m_remainingTasks[i]) {
-								if (remaining > 0) {
-									taskComplete = false;
-									break;
-								}
-							}
-							if (taskComplete) { completeTasks += 1; }
-						}
-						logger->updateSessionEntry(m_currBlock > m_sessConfig->blockCount, completeTasks, completeTrials);			// Update session entry in database
+						logger->updateSessionEntry(m_currBlock > m_sessConfig->blockCount, m_tasks.completeTasks(), m_tasks.completedTotal());			// Update session entry in database
 					}
 					if (m_sessConfig->logger.enable) {
 						endLogging();
 					}
 					m_app->markSessComplete(m_sessConfig->id);														// Add this session to user's completed sessions
 
-					m_feedbackMessage = formatFeedback(m_sessConfig->feedback.sessComplete);						// Update the feedback message
+					m_feedbackMessage = formatFeedback(m_sessConfig->feedback.sessCompleteMsg);						// Update the feedback message
 					m_currQuestionIdx = -1;
 
 					newState = PresentationState::complete;
@@ -734,14 +675,14 @@ void Session::updatePresentationState() {
 
 					Array<String> remaining = m_app->updateSessionDropDown();
 					if (remaining.size() == 0) {
-						m_feedbackMessage = formatFeedback(m_sessConfig->feedback.allSessComplete); // Update the feedback message
+						m_feedbackMessage = formatFeedback(m_sessConfig->feedback.allSessCompleteMsg); // Update the feedback message
 						moveOn = false;
 						if (m_app->experimentConfig.closeOnComplete || m_sessConfig->closeOnComplete) {
 							m_app->quitRequest();
 						}
 					}
 					else {
-						m_feedbackMessage = formatFeedback(m_sessConfig->feedback.sessComplete);	// Update the feedback message
+						m_feedbackMessage = formatFeedback(m_sessConfig->feedback.sessCompleteMsg);	// Update the feedback message
 						if (m_sessConfig->closeOnComplete) {
 							m_app->quitRequest();
 						}
@@ -757,7 +698,7 @@ void Session::updatePresentationState() {
 		else {
 			// Go ahead and move to the complete state since there aren't any valid sessions
 			newState = PresentationState::complete;
-			m_feedbackMessage = formatFeedback(m_app->experimentConfig.feedback.allSessComplete);
+			m_feedbackMessage = formatFeedback(m_app->experimentConfig.feedback.allSessCompleteMsg);
 			moveOn = false;
 			if (m_app->experimentConfig.closeOnComplete) {		// This is the case that is used for experiment config closeOnComplete!
 				m_app->quitRequest();
@@ -782,11 +723,10 @@ void Session::updatePresentationState() {
 			if (m_trialConfig->targetView.clearDecalsWithRef) {
 				m_weapon->clearDecals();
 			}
+			prefetchTrialTargets();			// Prepare the task targets now (keeping their creation out of the first frame of the task)
 		}
 		else if (newState == PresentationState::trialTask) {
-			if (m_sessConfig->render.frameTimeMode == "restartwithtask") {
-				m_frameTimeIdx = 0;		// Reset the frame time index with the task if requested
-			}
+			m_frameTimeSchedule.startTask();		// Restart the frame time schedule with the task (if requested)
 			// Test for aiming in valid region before spawning task targets				
 			if (m_trialConfig->timing.maxPretrialAimDisplacement >= 0) {
 				Vector3 aim = m_camera->frame().lookVector().unit();
@@ -795,12 +735,21 @@ void Session::updatePresentationState() {
 				float viewDisplacement = 180 / pif() * acosf(aim.dot(ref));
 				if (viewDisplacement > m_trialConfig->timing.maxPretrialAimDisplacement) {
 					clearTargets();		// Clear targets (in case preview targets are being shown)
-					m_feedbackMessage = formatFeedback(m_trialConfig->feedback.aimInvalid);
+					m_feedbackMessage = formatFeedback(m_trialConfig->feedback.aimInvalidMsg);
 					newState = PresentationState::trialFeedback;		// Jump to feedback state w/ error message
 				}
 			}
+			if (newState == PresentationState::trialTask) {
+				// Render costs and click-to-photon latency (per trial and frame rate condition) are reported for the task only
+				m_app->passTimer().clearSamples();
+				if (notNull(m_app->eventLogger())) m_app->eventLogger()->stats().startTrial(m_frameTimeSchedule.condition());
+			}
 			m_taskStartTime = FPSciLogger::genUniqueTimestamp();
 			initTargetAnimation(true);		// Spawn task targets (or convert from previews)
+			m_measureTrialStartFrame = true;
+		}
+		else if (newState == PresentationState::sessionFeedback) {
+			m_app->prefetchNextScene();		// Read the next session's scene from disk while feedback is shown
 		}
 		currentState = newState;
 	}
@@ -812,7 +761,6 @@ void Session::onSimulation(RealTime rdt, SimTime sdt, SimTime idt) {
 
 	// 2. Record target trajectories, view direction trajectories, and mouse motion.
 	accumulateTrajectories();
-	accumulateFrameInfo(rdt, sdt, idt);
 }
 
 bool Session::presentQuestions(Array<Question>& questions) {
@@ -873,45 +821,99 @@ void Session::recordTrialResponse(int destroyedTargets, int totalTargets) {
 			"'" + taskId + "'",
 			String(std::to_string(m_lastTaskIndex)),
 			"'" + m_trialConfig->id + "'",
-			String(std::to_string(m_completedTasks[m_currTaskIdx][m_currOrderIdx])),
+			String(std::to_string(m_tasks.completed(m_currTaskIdx, m_currOrderIdx))),
 			"'" + m_taskStartTime + "'",
 			"'" + m_taskEndTime + "'",
 			String(std::to_string(m_pretrialDuration)),
 			String(std::to_string(m_taskExecutionTime)),
 			String(std::to_string(destroyedTargets)),
-			String(std::to_string(totalTargets))
+			String(std::to_string(totalTargets)),
+			String(std::to_string(m_trialStartFrameTime))
 		};
-		logger->addTrialParamValues(trialValues, m_trialConfig);
+		logger->addTrialParamValues(trialValues, m_currTrialIdx);
 		logger->logTrial(trialValues);
 	}
 }
 
+void Session::recordRenderCosts() {
+	PassTimer& timer = m_app->passTimer();
+	timer.finish();				// Include the task's last frames (still in flight on the GPU)
+	if (notNull(logger) && m_trialConfig->logger.logRenderCosts) {
+		String taskId;
+		if (m_sessConfig->tasks.size() == 0) taskId = m_trialConfig->id;
+		else taskId = m_sessConfig->tasks[m_currTaskIdx].id;
+		const String timing = timer.gpuTiming() ? "'gpu'" : "'cpu'";
+		for (const String& pass : timer.passNames()) {
+			const int samples = timer.sampleCount(pass);
+			if (samples == 0) continue;
+			logger->logRenderCost({
+				"'" + m_sessConfig->id + "'",
+				"'" + taskId + "'",
+				String(std::to_string(getTaskCount(m_currTaskIdx))),
+				"'" + m_trialConfig->id + "'",
+				String(std::to_string(m_tasks.completed(m_currTaskIdx, m_currOrderIdx))),
+				"'" + pass + "'",
+				timing,
+				String(std::to_string(samples)),
+				String(std::to_string(1000.0f * timer.percentile(pass, 0.5f))),
+				String(std::to_string(1000.0f * timer.percentile(pass, 0.99f)))
+			});
+		}
+	}
+	timer.clearSamples();
+}
+
+void Session::recordClickLatencyStats() {
+	const shared_ptr<EventLogger> eventLogger = m_app->eventLogger();
+	if (isNull(logger) || isNull(eventLogger) || !eventLogger->running()) return;
+	String taskId;
+	if (m_sessConfig->tasks.size() == 0) taskId = m_trialConfig->id;
+	else taskId = m_sessConfig->tasks[m_currTaskIdx].id;
+	const LatencySketch trial = eventLogger->stats().trial();
+	logger->logClickLatencyStats({
+		"'" + m_sessConfig->id + "'",
+		"'" + taskId + "'",
+		String(std::to_string(getTaskCount(m_currTaskIdx))),
+		"'" + m_trialConfig->id + "'",
+		String(std::to_string(m_tasks.completed(m_currTaskIdx, m_currOrderIdx))),
+		"'" + eventLogger->stats().condition() + "'",
+		String(std::to_string(trial.count())),
+		String(std::to_string(trial.quantile(0.5f))),
+		String(std::to_string(trial.quantile(0.95f))),
+		String(std::to_string(trial.quantile(0.99f)))
+	});
+}
+
 void Session::accumulateTrajectories() {
 	if (notNull(logger) && m_trialConfig->logger.logTargetTrajectories) {
+		const FILETIME time = FPSciLogger::getFileTime();
+		const double now = System::time();
+		const Point3 viewer = m_camera->frame().translation;
 		for (shared_ptr<TargetEntity> target : m_targetArray) {
 			if (!target->isLogged()) continue;
-			String name = target->name();
-			Point3 pos = target->frame().translation;
-			TargetLocation location = TargetLocation(FPSciLogger::getFileTime(), name, currentState, pos);
-			if (m_trialConfig->logger.logOnChange) {
-				// Check for target in logged position table
-				if (m_lastLogTargetLoc.containsKey(name)  && location.noChangeFrom(m_lastLogTargetLoc[name])) {	
+			TrajectoryLogState& last = m_trajectoryLogStates[target->logIndex()];
+			const Point3 pos = target->frame().translation;
+			if (last.logged && last.state == int(currentState)) {
+				if (m_trialConfig->logger.logOnChange && pos == last.position) {
 					continue; // Duplicates last logged position/state (don't log)
 				}
+				if (!target->logDecimation().shouldLog(last, now, pos, viewer)) {
+					continue; // Decimated (state changes are always logged)
+				}
 			}
 			//// below for 2D direction calculation (azimuth and elevation)
 			//Point3 t = targetPosition.direction();
 			//float az = atan2(-t.z, -t.x) * 180 / pif();
 			//float el = atan2(t.y, sqrtf(t.x * t.x + t.z * t.z)) * 180 / pif();
-			logger->logTargetLocation(location);
-			m_lastLogTargetLoc.set(name, location);					// Update the last logged location
+			logger->logTargetLocation(TargetLocation(time, target->registryId(), currentState, pos));
+			last.update(now, pos, int(currentState));					// Update the last logged sample
 		}
 	}
 	// recording view direction trajectories
 	accumulatePlayerAction(PlayerActionType::Aim);
 }
 
-void Session::accumulatePlayerAction(PlayerActionType action, String targetName) {
+void Session::accumulatePlayerAction(PlayerActionType action, int targetId) {
 	// Count hits (in task state) here
 	if (currentState == PresentationState::trialTask) {
 		if (action == PlayerActionType::Miss) {
@@ -928,27 +930,41 @@ void Session::accumulatePlayerAction(PlayerActionType action, String targetName)
 		}
 	}
 
-	static PlayerAction lastPA;
-
 	if (notNull(logger) && m_trialConfig->logger.logPlayerActions) {
 		BEGIN_PROFILER_EVENT("accumulatePlayerAction");
 		// recording target trajectories
 		Point2 dir = getViewDirection();
 		Point3 loc = getPlayerLocation();
-		PlayerAction pa = PlayerAction(FPSciLogger::getFileTime(), dir, loc, currentState, action, targetName);
+		PlayerAction pa = PlayerAction(FPSciLogger::getFileTime(), dir, loc, currentState, action, targetId);
 		// Check for log only on change condition
-		if (m_trialConfig->logger.logOnChange && pa.noChangeFrom(lastPA)) {
-			return;		// Early exit for (would be) duplicate log entry
+		const LoggerConfig& logConfig = m_trialConfig->logger;
+		if (!(logConfig.logOnChange && m_playerActionLogged && 
+			pa.noChangeFrom(m_lastPlayerAction, logConfig.logOnChangeViewTolerance, logConfig.logOnChangePositionTolerance))) {
+			logger->logPlayerAction(pa);
+			m_lastPlayerAction = pa;		// Update last logged values
+			m_playerActionLogged = true;
 		}
-		logger->logPlayerAction(pa);
-		lastPA = pa;				// Update last logged values
 		END_PROFILER_EVENT();
 	}
 }
 
-void Session::accumulateFrameInfo(RealTime t, float sdt, float idt) {
+void Session::accumulateFrameInfo(FrameInfo& info) {
+	if (m_measureTrialStartFrame) {
+		// Record the work done in the frame the task started in (excluding any frame pacing wait)
+		m_trialStartFrameTime = info.userInputTime + info.networkTime + info.logicTime + info.simulationTime + info.poseTime + info.graphicsTime;
+		m_measureTrialStartFrame = false;
+	}
 	if (notNull(logger) && m_trialConfig->logger.logFrameInfo) {
-		logger->logFrameInfo(FrameInfo(FPSciLogger::getFileTime(), sdt));
+		info.loggerQueueDepth = logger->queueDepth();
+		logger->logFrameInfo(info);
+	}
+}
+
+void Session::accumulateLatencyEstimates(const Array<PhotonProxy::Estimate>& estimates) {
+	if (notNull(logger) && m_trialConfig->logger.logEstimatedLatency) {
+		for (const PhotonProxy::Estimate& e : estimates) {
+			logger->logEstimatedLatency(ClickLatency{ e.inputTicks, e.latencyMs(), e.mode() });
+		}
 	}
 }
 
@@ -968,27 +984,18 @@ float Session::getRemainingTrialTime() {
 float Session::getProgress() {
 	if (notNull(m_sessConfig)) {
 		// Get progress across tasks
-		float remainingTrialOrders = 0.f;
-		for (Array<int> trialOrderCounts : m_remainingTasks) {
-			for (int orderCount : trialOrderCounts) {
-				if (orderCount < 0) return 0.f;				// Infinite trials, never make any progress
-				remainingTrialOrders += (float)orderCount;
-			}
-		}
+		if (m_tasks.infinite()) return 0.f;				// Infinite trials, never make any progress
+		const float trialOrdersPerBlock = m_tasks.trialOrdersPerBlock();
 
 		// Get progress in current task
-		int completedTrialsInOrder = 0;
 		int totalTrialsInOrder = 1; // If there aren't tasks specified there is always 1 trial in this order (single order/trial task)
 		if(m_sessConfig->tasks.size() > 0) totalTrialsInOrder = m_sessConfig->tasks[m_currTaskIdx].trialOrders[m_currOrderIdx].order.length();
-		for (const String& trialId : m_completedTaskTrials.getKeys()) {
-			completedTrialsInOrder += m_completedTaskTrials[trialId];
-		}
-		float currTaskProgress = (float) completedTrialsInOrder / (float) totalTrialsInOrder;
+		float currTaskProgress = (float) m_completedTaskTrialCount / (float) totalTrialsInOrder;
 		
-		// Start by getting task-level progress (based on m_remainingTrialOrders)
-		float overallProgress = 1.f - (remainingTrialOrders / m_sessConfig->getTrialOrdersPerBlock());
+		// Start by getting task-level progress (based on the remaining trial orders)
+		float overallProgress = 1.f - ((float)m_tasks.remainingTotal() / trialOrdersPerBlock);
 		// Special case to avoid "double counting" completed tasks (if incomplete add progress in the current task, if complete it has been counted)
-		if (currTaskProgress < 1) overallProgress += currTaskProgress / m_sessConfig->getTrialOrdersPerBlock();
+		if (currTaskProgress < 1) overallProgress += currTaskProgress / trialOrdersPerBlock;
 		return overallProgress;
 	}
 	return fnan();
@@ -1021,106 +1028,55 @@ double Session::getScore() {
 	return m_trialConfig->feedback.scoreMultiplier * score;
 }
 
-String Session::formatCommand(const String& input) {
-	const char delimiter = '%';			///< Start of all valid substrings
-	String formatted = input;			///< Output string
-	int foundIdx = 0;					///< Index for searching for substrings
-
-	const String loggerComPort = "%loggerComPort";
-	const String syncComPort = "%loggerSyncComPort";
-	const String dbFilename = "%dbFilename";
-
-	while ((foundIdx = (int)formatted.find(delimiter, (size_t)foundIdx)) > -1) {
-		if (!formatted.compare(foundIdx, loggerComPort.length(), loggerComPort)) {
+const String& Session::formatCommand(const MessageTemplate& cmd) {
+	cmd.render(m_formatBuffer, [&](MessageTemplate::Var var, String& out) {
+		switch (var) {
+		case MessageTemplate::Var::LoggerComPort:
 			if (m_app->systemConfig.loggerComPort.empty()) {
 				throw "Found \"%loggerComPort\" substring in a command, but no \"loggerComPort\" is provided in the config!";
 			}
-			formatted = formatted.substr(0, foundIdx) + m_app->systemConfig.loggerComPort + formatted.substr(foundIdx + loggerComPort.length());
-		}
-		else if (!formatted.compare(foundIdx, syncComPort.length(), syncComPort)) {
+			out.append(m_app->systemConfig.loggerComPort);
+			break;
+		case MessageTemplate::Var::LoggerSyncComPort:
 			if (m_app->systemConfig.syncComPort.empty()) {
 				throw "Found \"%loggerSyncComPort\" substring in a command, but no \"loggerSyncComPort\" is provided in the config!";
 			}
-			formatted = formatted.substr(0, foundIdx) + m_app->systemConfig.syncComPort + formatted.substr(foundIdx + syncComPort.length());
-		}
-		else if (!formatted.compare(foundIdx, dbFilename.length(), dbFilename)) {
+			out.append(m_app->systemConfig.syncComPort);
+			break;
+		case MessageTemplate::Var::DbFilename:
 			if (m_dbFilename.empty()) {
 				throw "No database filename found to support the %dbFilename substring!";
 			}
-			formatted = formatted.substr(0, foundIdx) + m_dbFilename + formatted.substr(foundIdx + dbFilename.length());
-		}
-		else {
-			foundIdx++;
+			out.append(m_dbFilename);
+			break;
+		default:
+			break;
 		}
-	}
-	return formatted;
+	});
+	return m_formatBuffer;
 }
 
-String Session::formatFeedback(const String& input) {
-	const char delimiter = '%';			///< Start of all valid substrings
-	String formatted = input;			///< Output string
-	int foundIdx = 0;					///< Index for searching for substrings
-
-	// Substrings for replacement
-	const String totalTimeLeftS			= "%totalTimeLeftS";				///< Sum of time remaining over all completed trials
-	const String lastBlock				= "%lastBlock";						///< The last (completed) block in this session
-	const String currBlock				= "%currBlock";						///< The current block of the session (next block at end of session)
-	const String totalBlocks			= "%totalBlocks";					///< The total blocks specified in the session
-	const String trialTaskTimeMs		= "%trialTaskTimeMs";				///< The time spent in the task state of this trial (in ms)
-	const String trialTargetsDestroyed	= "%trialTargetsDestroyed";			///< The number of targets destroyed in this trial
-	const String trialTotalTargets		= "%trialTotalTargets";				///< The number of targets in this trial ("infinite" if any target respawns infinitely)
-	const String trialShotsHit			= "%trialShotsHit";					///< The number of shots hit in this trial
-	const String trialTotalShots		= "%trialTotalShots";				///< The number of shots taken in this trial
-	const String sessionScore			= "%sessionScore";					///< The score for this session
-
-	// Walk through the string looking for instances of the delimiter
-	while ((foundIdx = (int)formatted.find(delimiter, (size_t)foundIdx)) > -1) {
-		if(!formatted.compare(foundIdx, totalTimeLeftS.length(), totalTimeLeftS)){
-			formatted = formatted.substr(0, foundIdx) + format("%.2f", m_totalRemainingTime) + formatted.substr(foundIdx + totalTimeLeftS.length());
-		}
-		else if (!formatted.compare(foundIdx, lastBlock.length(), lastBlock)) {
-			formatted = formatted.substr(0, foundIdx) + format("%d", m_currBlock - 1) + formatted.substr(foundIdx + lastBlock.length());
-		}
-		else if (!formatted.compare(foundIdx, currBlock.length(), currBlock)) {
-			formatted = formatted.substr(0, foundIdx) + format("%d", m_currBlock) + formatted.substr(foundIdx + currBlock.length());
-		}
-		else if (!formatted.compare(foundIdx, totalBlocks.length(), totalBlocks)) {
-			formatted = formatted.substr(0, foundIdx) + format("%d", m_sessConfig->blockCount) + formatted.substr(foundIdx + totalBlocks.length());
-		}
-		else if (!formatted.compare(foundIdx, trialTaskTimeMs.length(), trialTaskTimeMs)) {
-			formatted = formatted.substr(0, foundIdx) + format("%d", (int)(m_taskExecutionTime * 1000)) + formatted.substr(foundIdx + trialTaskTimeMs.length());
-		}
-		else if (!formatted.compare(foundIdx, trialTargetsDestroyed.length(), trialTargetsDestroyed)) {
-			formatted = formatted.substr(0, foundIdx) + format("%d", m_destroyedTargets) + formatted.substr(foundIdx + trialTargetsDestroyed.length());
-		}
-		else if (!formatted.compare(foundIdx, trialTotalTargets.length(), trialTotalTargets)) {
-			String totalTargetsString;
-			int totalTargets = totalTrialTargets();
-			if (totalTargets > 0) {
-				// Finite target count
-				totalTargetsString += format("%d", totalTargets);
-			}
-			else { 
-				// Inifinite target count case
-				totalTargetsString += "infinite";
-			}
-			formatted = formatted.substr(0, foundIdx) + totalTargetsString + formatted.substr(foundIdx + trialTotalTargets.length());
-		}
-		else if (!formatted.compare(foundIdx, trialShotsHit.length(), trialShotsHit)) {
-			formatted = formatted.substr(0, foundIdx) + format("%d", m_trialShotsHit) + formatted.substr(foundIdx + trialShotsHit.length());
-		}
-		else if (!formatted.compare(foundIdx, trialTotalShots.length(), trialTotalShots)) {
-			formatted = formatted.substr(0, foundIdx) + format("%d", m_weapon->shotsTaken()) + formatted.substr(foundIdx + trialTotalShots.length());
-		}
-		else if (!formatted.compare(foundIdx, sessionScore.length(), sessionScore)) {
-			formatted = formatted.substr(0, foundIdx) + format("%d", (int)G3D::round(getScore())) + formatted.substr(foundIdx + sessionScore.length());
-		}
-		else {
-			// Bump the found index past this character (not a valid substring)
-			foundIdx++;
-		}
-	}
-	return formatted;
+const String& Session::formatFeedback(const MessageTemplate& msg) {
+	msg.render(m_formatBuffer, [&](MessageTemplate::Var var, String& out) {
+		switch (var) {
+		case MessageTemplate::Var::TotalTimeLeftS:			out.append(format("%.2f", m_totalRemainingTime)); break;					// Sum of time remaining over all completed trials
+		case MessageTemplate::Var::LastBlock:				out.append(format("%d", m_currBlock - 1)); break;							// The last (completed) block in this session
+		case MessageTemplate::Var::CurrBlock:				out.append(format("%d", m_currBlock)); break;								// The current block of the session (next block at end of session)
+		case MessageTemplate::Var::TotalBlocks:				out.append(format("%d", m_sessConfig->blockCount)); break;					// The total blocks specified in the session
+		case MessageTemplate::Var::TrialTaskTimeMs:			out.append(format("%d", (int)(m_taskExecutionTime * 1000))); break;		// The time spent in the task state of this trial (in ms)
+		case MessageTemplate::Var::TrialTargetsDestroyed:	out.append(format("%d", m_destroyedTargets)); break;						// The number of targets destroyed in this trial
+		case MessageTemplate::Var::TrialTotalTargets: {																					// The number of targets in this trial ("infinite" if any target respawns infinitely)
+			const int totalTargets = totalTrialTargets();
+			out.append(totalTargets > 0 ? format("%d", totalTargets) : String("infinite"));
+			break;
+		}
+		case MessageTemplate::Var::TrialShotsHit:			out.append(format("%d", m_trialShotsHit)); break;							// The number of shots hit in this trial
+		case MessageTemplate::Var::TrialTotalShots:			out.append(format("%d", m_weapon->shotsTaken())); break;					// The number of shots taken in this trial
+		case MessageTemplate::Var::SessionScore:			out.append(format("%d", (int)G3D::round(getScore()))); break;				// The score for this session
+		default: break;
+		}
+	});
+	return m_formatBuffer;
 }
 
 String Session::getFeedbackMessage() {
@@ -1148,7 +1104,14 @@ shared_ptr<TargetEntity> Session::spawnDestTarget(
 	const String nameStr = name.empty() ? format("target%03d", ++m_lastUniqueID) : name;
 	const int scaleIndex = clamp(iRound(log(targetSize) / log(1.0f + TARGET_MODEL_ARRAY_SCALING) + TARGET_MODEL_ARRAY_OFFSET), 0, TARGET_MODEL_SCALE_COUNT - 1);
 
-	const shared_ptr<TargetEntity>& target = TargetEntity::create(config, nameStr, m_scene, (*m_targetModels)[config->id][scaleIndex], offset, scaleIndex, paramIdx);
+	shared_ptr<TargetEntity> target = m_targetPool.acquire<TargetEntity>(config->id, scaleIndex);
+	if (notNull(target)) {
+		target->recycle(nameStr);
+		target->resetFromConfig(config, offset, scaleIndex, paramIdx);
+	}
+	else {
+		target = TargetEntity::create(config, nameStr, m_scene, m_app->targetModel(config->id, scaleIndex), offset, scaleIndex, paramIdx);
+	}
 
 	// Update parameters for the target
 	target->setHitSound(config->hitSound, m_app->soundTable, config->hitSoundVol);
@@ -1156,9 +1119,6 @@ shared_ptr<TargetEntity> Session::spawnDestTarget(
 
 	Color4 gloss = config->hasGloss ? config->gloss : m_app->experimentConfig.targetView.gloss;
 	target->setColor(color, gloss);
-
-	// Add target to array and scene
-	insertTarget(target);
 	return target;
 }
 
@@ -1171,12 +1131,12 @@ shared_ptr<FlyingEntity> Session::spawnReferenceTarget(
 	const int scaleIndex = clamp(iRound(log(size) / log(1.0f + TARGET_MODEL_ARRAY_SCALING) + TARGET_MODEL_ARRAY_OFFSET), 0, TARGET_MODEL_SCALE_COUNT - 1);
 
 	String refId = m_sessConfig->id + "_reference";
-	if (isNull(m_targetModels->getPointer(refId))) {
+	if (!m_app->hasTargetModel(refId)) {
 		// This session doesn't have a custom reference target
 		refId = "reference";
 	}
 
-	const shared_ptr<FlyingEntity>& target = FlyingEntity::create("reference", m_scene, (*m_targetModels)[refId][scaleIndex], CFrame());
+	const shared_ptr<FlyingEntity>& target = FlyingEntity::create("reference", m_scene, m_app->targetModel(refId, scaleIndex), CFrame());
 
 	// Setup additional target parameters
 	target->setFrame(position);
@@ -1198,10 +1158,17 @@ shared_ptr<FlyingEntity> Session::spawnFlyingTarget(
 	const float targetSize = G3D::Random().common().uniform(config->size[0], config->size[1]);
 	const int scaleIndex = clamp(iRound(log(targetSize) / log(1.0f + TARGET_MODEL_ARRAY_SCALING) + TARGET_MODEL_ARRAY_OFFSET), 0, TARGET_MODEL_SCALE_COUNT - 1);
 	const String nameStr = name.empty() ? format("target%03d", ++m_lastUniqueID) : name;
-	const bool isWorldSpace = config->destSpace == "world";
+	const bool isWorldSpace = config->destSpace == TargetConfig::DestSpace::World;
 
 	// Setup the target
-	const shared_ptr<FlyingEntity>& target = FlyingEntity::create(config, nameStr, m_scene, (*m_targetModels)[config->id][scaleIndex], orbitCenter, scaleIndex, paramIdx);
+	shared_ptr<FlyingEntity> target = m_targetPool.acquire<FlyingEntity>(config->id, scaleIndex);
+	if (notNull(target)) {
+		target->recycle(nameStr);
+		target->resetFromConfig(config, orbitCenter, scaleIndex, paramIdx);
+	}
+	else {
+		target = FlyingEntity::create(config, nameStr, m_scene, m_app->targetModel(config->id, scaleIndex), orbitCenter, scaleIndex, paramIdx);
+	}
 	target->setFrame(position);
 	target->setWorldSpace(isWorldSpace);
 	if (isWorldSpace) {
@@ -1212,9 +1179,6 @@ shared_ptr<FlyingEntity> Session::spawnFlyingTarget(
 
 	Color4 gloss = config->hasGloss ? config->gloss : m_app->experimentConfig.targetView.gloss;
 	target->setColor(color, gloss);
-
-	// Add the target to the scene/target array
-	insertTarget(target);
 	return target;
 }
 
@@ -1230,10 +1194,17 @@ shared_ptr<JumpingEntity> Session::spawnJumpingTarget(
 	const float targetSize = G3D::Random().common().uniform(config->size[0], config->size[1]);
 	const int scaleIndex = clamp(iRound(log(targetSize) / log(1.0f + TARGET_MODEL_ARRAY_SCALING) + TARGET_MODEL_ARRAY_OFFSET), 0, TARGET_MODEL_SCALE_COUNT - 1);
 	const String nameStr = name.empty() ? format("target%03d", ++m_lastUniqueID) : name;
-	const bool isWorldSpace = config->destSpace == "world";
+	const bool isWorldSpace = config->destSpace == TargetConfig::DestSpace::World;
 
 	// Setup the target
-	const shared_ptr<JumpingEntity>& target = JumpingEntity::create(config, nameStr, m_scene, (*m_targetModels)[config->id][scaleIndex], scaleIndex, orbitCenter, targetDistance, paramIdx);
+	shared_ptr<JumpingEntity> target = m_targetPool.acquire<JumpingEntity>(config->id, scaleIndex);
+	if (notNull(target)) {
+		target->recycle(nameStr);
+		target->resetFromConfig(config, orbitCenter, targetDistance, scaleIndex, paramIdx);
+	}
+	else {
+		target = JumpingEntity::create(config, nameStr, m_scene, m_app->targetModel(config->id, scaleIndex), scaleIndex, orbitCenter, targetDistance, paramIdx);
+	}
 	target->setFrame(position);
 	target->setWorldSpace(isWorldSpace);
 	if (isWorldSpace) {
@@ -1244,14 +1215,24 @@ shared_ptr<JumpingEntity> Session::spawnJumpingTarget(
 
 	Color4 gloss = config->hasGloss ? config->gloss : m_app->experimentConfig.targetView.gloss;
 	target->setColor(color, gloss);
-
-	// Add the target to the scene/target array
-	insertTarget(target);
 	return target;
 }
 
+int Session::registerTarget(const String& name) {
+	bool created = false;
+	int& id = m_targetIds.getCreate(name, created);
+	if (created) {
+		id = m_targetIds.size();			// Ids start at 1 (0 is no target)
+		if (notNull(logger)) logger->logTargetName(name);
+	}
+	return id;
+}
+
 void Session::insertTarget(shared_ptr<TargetEntity> target) {
 	target->setShouldBeSaved(false);
+	target->setRegistryId(registerTarget(target->name()));
+	target->setLogIndex(m_trajectoryLogStates.size());
+	m_trajectoryLogStates.append(TrajectoryLogState());
 	m_targetArray.append(target);
 	m_scene->insert(target);
 }
@@ -1259,9 +1240,12 @@ void Session::insertTarget(shared_ptr<TargetEntity> target) {
 void Session::destroyTarget(shared_ptr<TargetEntity> target) {
 	// Remove target from the scene
 	m_scene->removeEntity(target->name());
-	// Remove target from master list
+	// Remove target from master list (and return it to the pool for reuse by a later trial)
 	for (int i = 0; i < m_targetArray.size(); i++) {
-		if (m_targetArray[i]->name() == target->name()) { m_targetArray.fastRemove(i); }
+		if (m_targetArray[i]->name() == target->name()) {
+			m_targetPool.release(m_targetArray[i]);
+			m_targetArray.fastRemove(i);
+		}
 	}
 	// Remove target from (un)hittable array
 	for (int i = 0; i < m_hittableTargets.size(); i++) {
@@ -1278,7 +1262,10 @@ void Session::destroyTarget(shared_ptr<TargetEntity> target) {
 
 /** Clear all targets one by one */
 void Session::clearTargets() {
-	for(auto target : m_targetArray) {
-		destroyTarget(target);
+	while (m_targetArray.size() > 0) {
+		destroyTarget(m_targetArray.last());
 	}
+	for (const PreparedTarget& prepared : m_prefetchedTargets) { m_targetPool.release(prepared.entity); }
+	m_prefetchedTargets.fastClear();
+	m_trajectoryLogStates.fastClear();		// No targets remain to index the log states
 }
@@ -29,6 +29,10 @@
 
 #include <G3D/G3D.h>
 #include "FpsConfig.h"
+#include "FrameTimeSchedule.h"
+#include "TaskScheduler.h"
+#include "TargetPool.h"
+#include "PhotonProxy.h"
 #include <ctime>
 
 class FPSciApp;
@@ -54,35 +58,51 @@ public:
 
  struct FrameInfo {
 	FILETIME time;
-	//float idt = 0.0f;
-	float sdt = 0.0f;
+	float rdt = 0.0f;					///< Real time delta
+	float sdt = 0.0f;					///< Simulation time delta
+	float idt = 0.0f;					///< Ideal simulation time delta
+	float targetFrameTime = 0.0f;		///< Target frame time (from Session::targetFrameTime())
+	float pacingError = 0.0f;			///< Frame pacing error (actual - desired wait time)
+
+	// Per-stage durations (in seconds)
+	float userInputTime = 0.0f;
+	float networkTime = 0.0f;
+	float logicTime = 0.0f;
+	float simulationTime = 0.0f;
+	float poseTime = 0.0f;
+	float waitTime = 0.0f;
+	float graphicsTime = 0.0f;
+
+	int delayBufferIndex = 0;			///< Index (0 = oldest) of the delay buffer presented this frame
+	float addedLatency = 0.0f;			///< Display latency added by the delay buffers (in seconds)
+	int loggerQueueDepth = 0;			///< Count of records waiting to be written by the logger
 
 	FrameInfo() {};
+};
 
-	FrameInfo(FILETIME t, float simDeltaTime) {
-		time = t;
-		sdt = simDeltaTime;
-	}
+/** A trial target created (posed and colored) ahead of being inserted into the scene */
+struct PreparedTarget {
+	shared_ptr<TargetEntity>	entity;
+	shared_ptr<TargetConfig>	config;
+	String						name;
+	float						size = 0.0f;			///< Drawn target size (for logging)
+	Point2						eccentricity;			///< Drawn spawn eccentricity (H, V) in degrees (for logging)
 };
 
 struct TargetLocation {
 	FILETIME time;
-	String name = "";
+	int targetId = 0;							///< Session registry id of the target (see Session::registerTarget)
 	PresentationState state;
 	Point3 position = Point3::zero();
 
 	TargetLocation() {};
 
-	TargetLocation(FILETIME t, String targetName, PresentationState trialState, Point3 targetPosition) {
+	TargetLocation(FILETIME t, int id, PresentationState trialState, Point3 targetPosition) {
 		time = t;
-		name = targetName;
+		targetId = id;
 		state = trialState;
 		position = targetPosition;
 	}
-
-	inline bool noChangeFrom(const TargetLocation& other) const {
-		return state == other.state && position == other.position;
-	}
 };
 
 enum PlayerActionType{
@@ -100,21 +120,24 @@ struct PlayerAction {
 	Point3				position = Point3::zero();
 	PresentationState	state;
 	PlayerActionType	action = PlayerActionType::None;
-	String				targetName = "";
+	int					targetId = 0;				///< Session registry id of the target acted on (0 for none)
 
 	PlayerAction() {};
 
-	PlayerAction(FILETIME t, Point2 playerViewDirection, Point3 playerPosition, PresentationState trialState, PlayerActionType playerAction, String name) {
+	PlayerAction(FILETIME t, Point2 playerViewDirection, Point3 playerPosition, PresentationState trialState, PlayerActionType playerAction, int target = 0) {
 		time = t;
 		viewDirection = playerViewDirection;
 		position = playerPosition;
 		action = playerAction;
 		state = trialState;
-		targetName = name;
+		targetId = target;
 	}
 
-	inline bool noChangeFrom(const PlayerAction& other) const {
-		return viewDirection == other.viewDirection && position == other.position && action == other.action && state == other.state && targetName == other.targetName;
+	/** Is this action a duplicate of other, with view direction (in deg) and position (in m) within the given tolerances? */
+	inline bool noChangeFrom(const PlayerAction& other, float viewTolerance = 0.0f, float positionTolerance = 0.0f) const {
+		return action == other.action && state == other.state && targetId == other.targetId &&
+			abs(viewDirection.x - other.viewDirection.x) <= viewTolerance && abs(viewDirection.y - other.viewDirection.y) <= viewTolerance &&
+			(position - other.position).squaredLength() <= square(positionTolerance);
 	}
 };
 
@@ -124,7 +147,7 @@ public:
 	String			id;				///< Trial ID (used for logging and required for task affiliation)
 	Array<String>	targetIds;		///< Trial ID list
 	int				count = 1;		///< Count of trials to be performed
-	static int		defaultCount;	///< Default count to use
+	static thread_local int defaultCount;	///< Default count to use (per thread, as sessions are parsed in parallel)
 
 	TrialConfig() : FpsConfig(defaultConfig()) {};
 	TrialConfig(const Array<String>& targetIds, int trialCount) : targetIds(targetIds), count(trialCount) {};
@@ -135,7 +158,7 @@ public:
 	// Use a static method to bypass order of declaration for static members (specific to Sampler s_freeList in GLSamplerObect)
 	// Trick from: https://www.cs.technion.ac.il/users/yechiel/c++-faq/static-init-order-on-first-use.html	
 	static FpsConfig& defaultConfig() {
-		static FpsConfig def;
+		static thread_local FpsConfig def;			// Per thread, as each session sets this up before parsing its trials
 		def.questionArray = Array<Question>();		// Clear the questions array (don't inherit)
 		return def;
 	}
@@ -230,28 +253,34 @@ protected:
 	bool m_hasSession;									///< Flag indicating whether psych helper has loaded a valid session
 	int	m_currBlock = 1;								///< Index to the current block of trials
 	String m_feedbackMessage;							///< Message to show when trial complete
+	String m_formatBuffer;								///< Reusable buffer for rendering feedback messages/commands
 
 	// Target management
-	Table<String, Array<shared_ptr<ArticulatedModel>>>* m_targetModels;
 	int m_lastUniqueID = 0;									///< Counter for creating unique names for various entities
 	
 	Array<shared_ptr<TargetEntity>> m_targetArray;			///< Array of drawn targets
 	Array<shared_ptr<TargetEntity>> m_hittableTargets;		///< Array of targets that can be hit
 	Array<shared_ptr<TargetEntity>> m_unhittableTargets;	///< Array of targets that can't be hit
-
-	Table<String, TargetLocation> m_lastLogTargetLoc;		///< Last logged target location (used for logOnChange)
+	TargetPool m_targetPool;								///< Released trial targets (reused by later trials)
+	Array<PreparedTarget> m_prefetchedTargets;				///< Next task's targets (prepared during pretrial, hidden until inserted at the start of the task)
+	Point3 m_prefetchSpawnPos;								///< Player position the prefetched targets were spawned around
+
+	Array<TrajectoryLogState> m_trajectoryLogStates;		///< Last logged trajectory sample of each target (indexed by the target's log index)
+	PlayerAction m_lastPlayerAction;						///< Last logged player action (used for logOnChange)
+	bool m_playerActionLogged = false;						///< Has a player action been logged (this session)?
+	Table<String, int> m_targetIds;							///< Registry of target names to dense ids (used in log records, 0 is reserved for no target)
 	Point3 m_lastRefTargetPos;								///< Last reference target location (used for aim invalidation)
 
-	int m_frameTimeIdx = 0;									///< Frame time index
+	FrameTimeSchedule m_frameTimeSchedule;					///< Frame time schedule (compiled at the start of each trial)
 	int m_currTaskIdx;										///< Current task index (from tasks array)
 	int m_currOrderIdx;										///< Current trial order index
 	int m_currTrialIdx;										///< Current trial index (from the trials array)
 	int m_currQuestionIdx = -1;								///< Current question index
 	Array<int> m_taskTrials;								///< Indexes of trials (from trials array) for this task
-	Array<Array<int>> m_remainingTasks;						///< Count of remaining trials of each order
-	Array<Array<int>> m_completedTasks;						///< Count of completions of each trial order
+	TaskScheduler m_tasks;									///< Remaining/completed count of each task trial order (picks the next task)
 	int m_lastTaskIndex = 0;								///< Used for providing task index on questions
 	Table<String, int> m_completedTaskTrials;				///< Count of completed trial types in this task
+	int m_completedTaskTrialCount = 0;						///< Count of completed trials (of any type) in this task
 	Array<Array<shared_ptr<TargetConfig>>> m_targetConfigs;	///< Target configurations by trial
 
 	// Time-based parameters
@@ -260,6 +289,8 @@ protected:
 	String m_taskStartTime;								///< Recorded task start timestamp							
 	String m_taskEndTime;								///< Recorded task end timestamp
 	Timer m_timer;										///< Timer used for timing tasks	
+	bool m_measureTrialStartFrame = false;				///< Record the duration of the next frame as the trial start frame time?
+	float m_trialStartFrameTime = 0.0f;					///< Duration (less frame pacing wait) of the frame the task started in (in seconds)
 	// Could move timer above to stopwatch in future
 	//Stopwatch stopwatch;			
 
@@ -280,12 +311,7 @@ protected:
 	Session(FPSciApp* app, shared_ptr<SessionConfig> config);
 	Session(FPSciApp* app);
 
-	~Session(){
-		clearTargets();					// Clear the targets when the session is done
-		// For now leave "orphaned" processes to allow (session) end commands to run until completion
-		//closeTrialProcesses();		// Close any trial processes affiliated with this session
-		//closeSessionProcesses();		// Close any processes affiliated with this session
-	}
+	~Session();
 
 	inline void runTrialCommands(String evt) {
 		evt = toLower(evt);
@@ -317,12 +343,15 @@ protected:
 		m_sessProcesses.clear();
 	}
 
-	String formatFeedback(const String& input);
-	String formatCommand(const String& input);
+	/** Render a (compiled) feedback message/command into m_formatBuffer (valid until the next call) */
+	const String& formatFeedback(const MessageTemplate& msg);
+	const String& formatCommand(const MessageTemplate& cmd);
 	bool presentQuestions(Array<Question>& questions);
 
 	/** Insert a target into the target array/scene */
 	inline void insertTarget(shared_ptr<TargetEntity> target);
+	/** Get the (dense, session-scoped) registry id for a target name, registering new names with the logger */
+	int registerTarget(const String& name);
 
 	/** Get the total target count for the current trial */
 	int totalTrialTargets() const {
@@ -401,7 +430,8 @@ protected:
 		ZeroMemory(&pi, sizeof(pi));
 
 		// Run the (formatted command)
-		LPSTR command = LPSTR(formatCommand(cmd.cmdStr).c_str());
+		String formatted = formatCommand(cmd.command);
+		LPSTR command = LPSTR(formatted.c_str());
 		bool success;
 		if (cmd.foreground) {	// Run process in the foreground
 			success = CreateProcess(NULL, command, NULL, NULL, FALSE, CREATE_NEW_CONSOLE, NULL, NULL, &si, &pi);
@@ -450,11 +480,18 @@ public:
 	void randomizePosition(const shared_ptr<TargetEntity>& target) const;
 	void initTargetAnimation(const bool task);
 	void spawnTrialTargets(Point3 initialSpawnPos, bool previewMode = false);
+	/** Create (but don't insert) the current trial's targets around initialSpawnPos */
+	void prepareTrialTargets(Point3 initialSpawnPos, bool previewMode, Array<PreparedTarget>& targets);
+	/** Log and insert prepared targets into the scene/target arrays (clearing the prepared array) */
+	void insertTrialTargets(Array<PreparedTarget>& targets, bool previewMode, const String& spawnTime);
+	/** Prepare the next task's targets (called during pretrial so the start of the task only needs to insert them) */
+	void prefetchTrialTargets();
 
 	bool blockComplete() const;
 	bool nextTrial();
 
 	const RealTime targetFrameTime();
+	const FrameTimeSchedule& frameTimeSchedule() const { return m_frameTimeSchedule; }
 
 	void endLogging();
 
@@ -472,8 +509,15 @@ public:
 	void onSimulation(RealTime rdt, SimTime sdt, SimTime idt);
 	void processResponse();
 	void recordTrialResponse(int destroyedTargets, int totalTargets);
+	/** Log the p50/p99 time of each render pass over the trial (and reset the pass timing samples) */
+	void recordRenderCosts();
+	/** Log the click-to-photon latency statistics for the trial (when a hardware event logger is running) */
+	void recordClickLatencyStats();
 	void accumulateTrajectories();
-	void accumulateFrameInfo(RealTime rdt, float sdt, float idt);
+	/** Log the timing info for a frame (called once all stages of the frame have completed) */
+	void accumulateFrameInfo(FrameInfo& info);
+	/** Log the software estimated click-to-present latency for any shots completed this frame */
+	void accumulateLatencyEstimates(const Array<PhotonProxy::Estimate>& estimates);
 
 	void countDestroy() {
 		m_destroyedTargets++;
@@ -494,8 +538,9 @@ public:
 	int getTaskCount(const int currTaskIdx) const;
 
 	/** queues action with given name to insert into database when trial completes
-	@param action - one of "aim" "hit" "miss" or "invalid (shots limited by fire rate)" */
-	void accumulatePlayerAction(PlayerActionType action, String target="");
+	@param action - one of "aim" "hit" "miss" or "invalid (shots limited by fire rate)"
+	@param targetId - registry id of the target acted on (see TargetEntity::registryId(), 0 for none) */
+	void accumulatePlayerAction(PlayerActionType action, int targetId = 0);
 	
 	bool nextBlock(bool init = false);
 
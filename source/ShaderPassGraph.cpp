@@ -0,0 +1,92 @@
+#include "ShaderPassGraph.h"
+
+void ShaderPassGraph::clear() {
+	m_configs.fastClear();
+	m_passes.fastClear();
+	m_targets.fastClear();
+	m_output = STAGE_INPUT;
+	m_skipped = 0;
+}
+
+void ShaderPassGraph::build(const Array<ShaderPassConfig>& passes, int inputWidth, int inputHeight, int outputWidth, int outputHeight, bool outputIsInput) {
+	clear();
+	m_configs = passes;
+
+	// Logical resources (the output of each pass that runs), resource 0 is the stage input
+	Array<Target> resources = { Target{ inputWidth, inputHeight } };
+	Array<int> lastUse = { -1 };						// Index of the last pass reading each resource
+	Table<String, int> named;							// Resource written by each (named) pass
+
+	int previous = 0;
+	for (int i = 0; i < passes.size(); i++) {
+		const ShaderPassConfig& config = passes[i];
+		int input = previous;
+		if (!config.input.empty() && !named.get(config.input, input)) {
+			throw format("Shader pass \"%s\" input (\"%s\") is not the name of an earlier pass!", config.name.c_str(), config.input.c_str());
+		}
+
+		const Target size = config.resolution[0] > 0 ?
+			Target{ config.resolution[0], config.resolution[1] } : resources[input];
+
+		int output = input;
+		if (!config.shader.empty() || size.width != resources[input].width || size.height != resources[input].height) {
+			output = resources.size();
+			resources.append(size);
+			lastUse.append(m_passes.size());
+			lastUse[input] = m_passes.size();
+			m_passes.append(Pass{ i, input, output, config.stage + " Pass: " + config.name });
+		}
+		else {
+			// Pass-through (no shader, no resize), alias the output to the input instead of copying
+			m_skipped++;
+		}
+		if (!config.name.empty()) named.set(config.name, output);
+		previous = output;
+	}
+
+	// The final output is read after the last pass (when copied into the stage output)
+	lastUse[previous] = m_passes.size();
+
+	// Check whether the last pass can write the stage output directly
+	bool direct = false;
+	if (m_passes.size() > 0 && outputWidth > 0) {
+		const Pass& last = m_passes.last();
+		direct = last.output == previous &&
+			resources[previous].width == outputWidth && resources[previous].height == outputHeight &&
+			!(outputIsInput && last.input == 0);
+	}
+
+	// Assign targets, reusing any target (of the same size) whose resource is no longer in use
+	Array<int> targetOf;								// Target for each resource
+	targetOf.resize(resources.size());
+	targetOf[0] = STAGE_INPUT;
+	Array<int> busyUntil;								// Last pass using each target
+	for (int p = 0; p < m_passes.size(); p++) {
+		const int resource = m_passes[p].output;
+		if (direct && p == m_passes.size() - 1) {
+			targetOf[resource] = STAGE_OUTPUT;
+			continue;
+		}
+		int target = -1;
+		for (int t = 0; t < m_targets.size(); t++) {
+			if (busyUntil[t] < p && m_targets[t].width == resources[resource].width && m_targets[t].height == resources[resource].height) {
+				target = t;
+				break;
+			}
+		}
+		if (target < 0) {
+			target = m_targets.size();
+			m_targets.append(resources[resource]);
+			busyUntil.append(0);
+		}
+		busyUntil[target] = lastUse[resource];
+		targetOf[resource] = target;
+	}
+
+	// Resolve passes from resources to targets
+	for (Pass& pass : m_passes) {
+		pass.input = targetOf[pass.input];
+		pass.output = targetOf[pass.output];
+	}
+	m_output = targetOf[previous];
+}
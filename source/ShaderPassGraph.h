@@ -0,0 +1,50 @@
+#pragma once
+
+#include <G3D/G3D.h>
+#include "FpsConfig.h"
+
+/** Compiles an ordered list of shader passes (for a single render stage) into the passes that need to run
+	and the (transient) render targets they require. Passes that would only copy their input (no shader, same
+	resolution) are skipped, and targets are shared between passes whose outputs are not in use at the same time.
+	Building the graph doesn't require a RenderDevice, targets are allocated by the caller. */
+class ShaderPassGraph {
+public:
+	static const int STAGE_INPUT = -1;				///< Target index used for the stage input
+	static const int STAGE_OUTPUT = -2;				///< Target index used when a pass writes the stage output directly
+
+	/** A pass to run */
+	struct Pass {
+		int		config;								///< Index of the pass configuration
+		int		input;								///< Index of the target to read (or STAGE_INPUT)
+		int		output;								///< Index of the target to write (or STAGE_OUTPUT)
+		String	timerName;							///< Name used to time (and log) this pass
+	};
+
+	/** A (transient) render target */
+	struct Target {
+		int		width;
+		int		height;
+	};
+
+protected:
+	Array<ShaderPassConfig>		m_configs;			///< Pass configurations (in order)
+	Array<Pass>					m_passes;			///< Passes to run (in order)
+	Array<Target>				m_targets;			///< Targets required by the passes
+	int							m_output = STAGE_INPUT;	///< Target holding the final output of the stage
+	int							m_skipped = 0;		///< Number of passes skipped (pass-through)
+
+public:
+	/** Build the graph for a set of passes. When an output size is provided, the last pass writes the stage output
+		directly if it matches that size (and isn't reading the stage input when outputIsInput is set). */
+	void build(const Array<ShaderPassConfig>& passes, int inputWidth, int inputHeight, int outputWidth = 0, int outputHeight = 0, bool outputIsInput = false);
+
+	void clear();
+
+	const Array<Pass>& passes() const { return m_passes; }
+	const Array<Target>& targets() const { return m_targets; }
+	const ShaderPassConfig& config(const Pass& pass) const { return m_configs[pass.config]; }
+
+	/** Index of the target holding the stage output (STAGE_INPUT when no passes run, STAGE_OUTPUT when written directly) */
+	int output() const { return m_output; }
+	int skippedCount() const { return m_skipped; }
+};
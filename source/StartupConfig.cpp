@@ -87,6 +87,7 @@ StartupConfig::StartupConfig(const Any& any) {
 		reader.getIfPresent("fullscreen", fullscreen);
 		reader.getIfPresent("windowSize", windowSize);
 		reader.getIfPresent("jsonAnyOutput", jsonAnyOutput);
+		reader.getIfPresent("cacheExperimentConfig", cacheExperimentConfig);
 
 		foundDefault = reader.getIfPresent("defaultExperiment", defaultExperiment);
 		if (!foundDefault) {
@@ -148,6 +149,7 @@ Any StartupConfig::toAny(const bool forceAll) const {
 	if (forceAll || def.fullscreen != fullscreen)									a["fullscreen"] = fullscreen;
 	if (forceAll || def.audioEnable != audioEnable)									a["audioEnable"] = audioEnable;
 	if (forceAll || def.jsonAnyOutput != jsonAnyOutput)									a["jsonAnyOutput"] = jsonAnyOutput;
+	if (forceAll || def.cacheExperimentConfig != cacheExperimentConfig)				a["cacheExperimentConfig"] = cacheExperimentConfig;
 	a["defaultExperiment"] = defaultExperiment;
 	a["experimentList"] = experimentList;
 
@@ -158,7 +160,7 @@ bool StartupConfig::validateExperiments() const {
 	// Validate experiment configs
 	bool valid = true;
 	for (auto& configs : experimentList) {
-		ExperimentConfig experimentConfig = ExperimentConfig::load(configs.experimentConfigFilename, jsonAnyOutput);
+		ExperimentConfig experimentConfig = ExperimentConfig::load(configs.experimentConfigFilename, jsonAnyOutput, cacheExperimentConfig);
 		logPrintf("Validating experiment '%s'\n", configs.name);
 		if (!experimentConfig.validate(false)) {
 			logPrintf("  Error: experiment '%s' is not valid! (See '%s')\n", configs.name, configs.experimentConfigFilename);
@@ -23,6 +23,14 @@ TargetConfig::TargetConfig(const Any& any) {
 		//reader.getIfPresent("elevationLocked", elevLocked);
 		reader.getIfPresent("upperHemisphereOnly", upperHemisphereOnly);
 		reader.getIfPresent("logTargetTrajectory", logTargetTrajectory);
+		reader.getEnumIfPresent("trajectoryLogMode", trajectoryDecimation.mode, TrajectoryDecimation::modeNames());
+		reader.getIfPresent("trajectoryLogRate", trajectoryDecimation.rate);
+		reader.getIfPresent("trajectoryLogMinDistance", trajectoryDecimation.minDistance);
+		reader.getIfPresent("trajectoryLogMinAngle", trajectoryDecimation.minAngle);
+		reader.getIfPresent("trajectoryLogTolerance", trajectoryDecimation.tolerance);
+		if (trajectoryDecimation.mode == TrajectoryDecimation::Mode::Rate && trajectoryDecimation.rate <= 0.0f) {
+			throw format("A \"trajectoryLogRate\" > 0 must be provided for \"rate\" trajectory logging! See target: \"%s\"", id);
+		}
 		reader.getIfPresent("distance", distance);
 		reader.getIfPresent("motionChangePeriod", motionChangePeriod);
 		reader.getIfPresent("speed", speed);
@@ -41,10 +49,10 @@ TargetConfig::TargetConfig(const Any& any) {
 		reader.getIfPresent("destroyDecalScale", destroyDecalScale);
 		reader.getIfPresent("destroyDecalDuration", destroyDecalDuration);
 
-		reader.getIfPresent("destSpace", destSpace);
+		reader.getEnumIfPresent("destSpace", destSpace, destSpaceNames());
 		reader.getIfPresent("destinations", destinations);
 		reader.getIfPresent("respawnCount", respawnCount);
-		if (destSpace == "world" && destinations.size() == 0) {
+		if (destSpace == DestSpace::World && destinations.size() == 0) {
 			reader.get("moveBounds", moveBounds, format("A world-space target must either specify destinations or a movement bounding box. See target: \"%s\"", id));
 			spawnBounds = moveBounds;
 		}
@@ -54,7 +62,7 @@ TargetConfig::TargetConfig(const Any& any) {
 			}
 		}
 		reader.getIfPresent("spawnBounds", spawnBounds);
-		if (destSpace == "world" && destinations.size() == 0 && !moveBounds.contains(spawnBounds)) {
+		if (destSpace == DestSpace::World && destinations.size() == 0 && !moveBounds.contains(spawnBounds)) {
 			String moveBoundStr = format("AABox{%s, %s}", moveBounds.high().toString(), moveBounds.low().toString());
 			String spawnBoundStr = format("AABox{%s, %s}", spawnBounds.high().toString(), spawnBounds.low().toString());
 			throw format("The \"moveBounds\" AABox (=%s) must contain the \"spawnBounds\" AABox (=%s)!", moveBoundStr, spawnBoundStr);
@@ -94,10 +102,16 @@ Any TargetConfig::toAny(const bool forceAll) const {
 	TargetConfig def;
 	a["id"] = id;
 	if (forceAll || !(def.modelSpec == modelSpec))							a["modelSpec"] = modelSpec;
-	if (forceAll || def.destSpace != destSpace)								a["destSpace"] = destSpace;
+	if (forceAll || def.destSpace != destSpace)								a["destSpace"] = destSpaceNames()[int(destSpace)];
 	if (forceAll || def.respawnCount != respawnCount)						a["respawnCount"] = respawnCount;
 	if (forceAll || def.size != size)										a["visualSize"] = size;
 	if (forceAll || def.logTargetTrajectory != logTargetTrajectory)			a["logTargetTrajectory"] = logTargetTrajectory;
+	const TrajectoryDecimation& defDec = def.trajectoryDecimation;
+	if (forceAll || defDec.mode != trajectoryDecimation.mode)				a["trajectoryLogMode"] = TrajectoryDecimation::modeNames()[int(trajectoryDecimation.mode)];
+	if (forceAll || defDec.rate != trajectoryDecimation.rate)				a["trajectoryLogRate"] = trajectoryDecimation.rate;
+	if (forceAll || defDec.minDistance != trajectoryDecimation.minDistance)	a["trajectoryLogMinDistance"] = trajectoryDecimation.minDistance;
+	if (forceAll || defDec.minAngle != trajectoryDecimation.minAngle)		a["trajectoryLogMinAngle"] = trajectoryDecimation.minAngle;
+	if (forceAll || defDec.tolerance != trajectoryDecimation.tolerance)		a["trajectoryLogTolerance"] = trajectoryDecimation.tolerance;
 	// Destination-based target
 	if (destinations.size() > 0) 											a["destinations"] = destinations;
 	// Parametric target
@@ -179,8 +193,7 @@ shared_ptr<TargetEntity> TargetEntity::create(
 	const shared_ptr<TargetEntity>& target = createShared<TargetEntity>();
 	target->Entity::init(name, scene, CFrame(config->destinations[0].position), shared_ptr<Entity::Track>(), true, true);
 	target->VisibleEntity::init(model, true, Surface::ExpressiveLightScatteringProperties(), ArticulatedModel::PoseSpline());
-	target->TargetEntity::init(config->destinations, paramIdx, offset, config->respawnCount, scaleIdx, config->logTargetTrajectory);
-	target->m_id = config->id;
+	target->resetFromConfig(config, offset, scaleIdx, paramIdx);
 	return target;
 }
 
@@ -315,7 +328,13 @@ shared_ptr<FlyingEntity> FlyingEntity::create(
 	// Initialize each base class, which parses its own fields
 	flyingEntity->Entity::init(name, scene, CFrame(), shared_ptr<Entity::Track>(), true, true);
 	flyingEntity->VisibleEntity::init(model, true, Surface::ExpressiveLightScatteringProperties(), ArticulatedModel::PoseSpline());
-	flyingEntity->FlyingEntity::init(
+	flyingEntity->resetFromConfig(config, orbitCenter, scaleIdx, paramIdx);
+	return flyingEntity;
+}
+
+void FlyingEntity::resetFromConfig(const shared_ptr<TargetConfig>& config, const Point3& orbitCenter, int scaleIdx, int paramIdx) {
+	m_destinationPoints.fastClear();
+	init(
 		{ config->speed[0], config->speed[1] }, 
 		{ config->motionChangePeriod[0], config->motionChangePeriod[1] },
 		config->upperHemisphereOnly, 
@@ -325,8 +344,8 @@ shared_ptr<FlyingEntity> FlyingEntity::create(
 		config->respawnCount, 
 		scaleIdx, 
 		config->logTargetTrajectory);
-	flyingEntity->m_id = config->id;
-	return flyingEntity;
+	m_id = config->id;
+	m_logDecimation = config->trajectoryDecimation;
 }
 
 
@@ -584,7 +603,13 @@ shared_ptr<JumpingEntity> JumpingEntity::create(
 	// Initialize each base class, which parses its own fields
 	jumpingEntity->Entity::init(name, scene, CFrame(), shared_ptr<Entity::Track>(), true, true);
 	jumpingEntity->VisibleEntity::init(model, true, Surface::ExpressiveLightScatteringProperties(), ArticulatedModel::PoseSpline());
-	jumpingEntity->JumpingEntity::init(
+	jumpingEntity->resetFromConfig(config, orbitCenter, targetDistance, scaleIdx, paramIdx);
+	return jumpingEntity;
+}
+
+void JumpingEntity::resetFromConfig(const shared_ptr<TargetConfig>& config, const Point3& orbitCenter, float targetDistance, int scaleIdx, int paramIdx) {
+	m_isFirstFrame = true;
+	init(
 		{ config->speed[0], config->speed[1] },
 		{ config->motionChangePeriod[0], config->motionChangePeriod[1] },
 		{ config->jumpPeriod[0], config->jumpPeriod[1] },
@@ -598,9 +623,8 @@ shared_ptr<JumpingEntity> JumpingEntity::create(
 		config->respawnCount,
 		scaleIdx,
 		config->logTargetTrajectory);
-	jumpingEntity->m_id = config->id;
-
-	return jumpingEntity;
+	m_id = config->id;
+	m_logDecimation = config->trajectoryDecimation;
 }
 
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <G3D/G3D.h>
 #include "FPSciAnyTableReader.h"
+#include "TrajectoryDecimation.h"
 
 struct Destination {
 public:
@@ -48,10 +49,17 @@ public:
 /** Class for representing a given target configuration */
 class TargetConfig : public ReferenceCountedObject {
 public:
+	enum class DestSpace { World, Player };
+	static const Array<String>& destSpaceNames() {
+		static const Array<String> names = { "world", "player" };
+		return names;
+	}
+
 	String			id;										///< Trial ID to indentify affiliated trial runs
 	//bool    		elevLocked = false;						///< Elevation locking
 	bool			upperHemisphereOnly = false;            ///< Limit flying motion to upper hemisphere only
 	bool			logTargetTrajectory = true;				///< Log this target's trajectory
+	TrajectoryDecimation trajectoryDecimation;				///< Which frames this target's trajectory is logged for
 	Array<float>	distance = { 30.0f, 40.0f };			///< Distance to the target
 	Array<float>	motionChangePeriod = { 1.0f, 1.0f };	///< Range of motion change period in seconds
 	Array<float>	speed = { 0.0f, 5.5f };					///< Range of angular velocities for target
@@ -65,7 +73,7 @@ public:
 	Array<float>	jumpSpeed = { 2.0f, 5.5f };				///< Range of jump speeds in meters/s
 	Array<float>	accelGravity = { 9.8f, 9.8f };			///< Range of acceleration due to gravity in meters/s^2
 	Array<Destination> destinations;						///< Array of destinations to traverse
-	String			destSpace = "world";					///< Space to use for destinations (implies offset) can be "world" or "player"
+	DestSpace		destSpace = DestSpace::World;			///< Space to use for destinations (implies offset) can be "world" or "player"
 	int				respawnCount = 0;						///< Number of times to respawn
 	AABox			spawnBounds;							///< Spawn position bounding box
 	AABox			moveBounds;								///< Movemvent bounding box
@@ -128,6 +136,9 @@ protected:
 	bool	m_worldSpace		= false;			///< World space coordiantes?
 	int		m_scaleIdx			= 0;				///< Index for scaled model
 	bool	m_isLogged			= true;				///< Control flag for logging
+	int		m_logIdx			= -1;				///< Index of this target's trajectory log state (in the session)
+	int		m_registryId		= 0;				///< Session registry id of this target's name (used in log records)
+	TrajectoryDecimation m_logDecimation;			///< Which frames this target's trajectory is logged for
 	Point3	m_offset;								///< Offset for initial spawn
 	bool	m_canHit			= true;				///< Can this target be hit?	
 	Array<Destination> m_destinations;				///< Array of destinations to visit
@@ -140,6 +151,11 @@ protected:
 	SimTime m_nextChangeTime = 0;
 	Vector3 m_velocity = Vector3::zero();
 
+	// Last pose created by setColor() (reused while the color doesn't change)
+	shared_ptr<ArticulatedModel::Pose> m_colorPose;
+	Color3	m_poseColor;
+	Color4	m_poseGloss;
+
 public:
 	TargetEntity() {}
 
@@ -174,6 +190,10 @@ public:
 	}
 
 	void setColor(const Color3& color, const Color4& gloss = Color4()) {
+		if (notNull(m_colorPose) && color == m_poseColor && gloss == m_poseGloss) {
+			setPose(m_colorPose);		// Reuse the material (i.e. for a pooled target)
+			return;
+		}
 		UniversalMaterial::Specification materialSpecification;
 		materialSpecification.setLambertian(Texture::Specification(color));
 		materialSpecification.setEmissive(Texture::Specification(color * 0.7f));
@@ -182,6 +202,25 @@ public:
 		const shared_ptr<ArticulatedModel::Pose>& amPose = ArticulatedModel::Pose::create();
 		amPose->materialTable.set("core/icosahedron_default", UniversalMaterial::create(materialSpecification));
 		setPose(amPose);
+		m_colorPose = amPose;
+		m_poseColor = color;
+		m_poseGloss = gloss;
+	}
+
+	/** Prepare a (pooled) target to be reused as a new target with this name (before it is reinserted into the scene) */
+	void recycle(const String& name) {
+		m_name = name;
+		respawn();
+		resetMotionParams();
+		m_velocity = Vector3::zero();
+		m_canHit = true;
+	}
+
+	/** Reset the destinations and parameters from a (destination-based) target config */
+	void resetFromConfig(const shared_ptr<TargetConfig>& config, const Point3& offset, int scaleIdx, int paramIdx) {
+		init(config->destinations, paramIdx, offset, config->respawnCount, scaleIdx, config->logTargetTrajectory);
+		m_id = config->id;
+		m_logDecimation = config->trajectoryDecimation;
 	}
 
 	void setWorldSpace(bool worldSpace) { m_worldSpace = worldSpace; }
@@ -261,6 +300,14 @@ public:
 	int scaleIndex() const { return m_scaleIdx; }
 	/** Getter for logging */
 	bool isLogged() const { return m_isLogged; }
+	/** Getter for the trajectory log decimation */
+	const TrajectoryDecimation& logDecimation() const { return m_logDecimation; }
+	/** Index of this target's trajectory log state (assigned when inserted in a session) */
+	int logIndex() const { return m_logIdx; }
+	void setLogIndex(int idx) { m_logIdx = idx; }
+	/** Session registry id of this target's name (assigned when inserted in a session) */
+	int registryId() const { return m_registryId; }
+	void setRegistryId(int id) { m_registryId = id; }
 	/** Getter for health */
 	float health() const { return m_health; }
 	/** Getter for the total time for a path*/
@@ -321,6 +368,9 @@ public:
 	void setBounds(AABox bounds) { m_bounds = bounds; }
 	AABox bounds() { return m_bounds; }
 
+	/** Reset the motion parameters from a target config (for new or pooled targets) */
+	void resetFromConfig(const shared_ptr<TargetConfig>& config, const Point3& orbitCenter, int scaleIdx, int paramIdx);
+
 	void setSpeed(float speed) {
 		m_speed = speed;
 	}
@@ -434,6 +484,9 @@ public:
 
 	void setMoveBounds(AABox bounds) { m_moveBounds = bounds; }
 
+	/** Reset the motion parameters from a target config (for new or pooled targets) */
+	void resetFromConfig(const shared_ptr<TargetConfig>& config, const Point3& orbitCenter, float targetDistance, int scaleIdx, int paramIdx);
+
 	/** For deserialization from Any / loading from file */
 	static shared_ptr<Entity> create (
 		const String&					name,
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <G3D/G3D.h>
+#include <type_traits>
+#include "TargetEntity.h"
+
+/** Pool of released trial targets, reused by later trials instead of creating new entities (and their model poses/materials).
+	Targets are keyed by target config id and model scale index (so the model matches) and are kept out of the scene while pooled. */
+class TargetPool {
+protected:
+	Table<String, Array<shared_ptr<TargetEntity>>>	m_free;				///< Released targets by target config id
+	int												m_freeCount = 0;	///< Count of released targets in the pool
+	int												m_hits = 0;			///< Count of targets reused from the pool
+	int												m_misses = 0;		///< Count of targets that had to be created
+
+	/** Is this target's concrete type T? createShared() instantiates a (local) subclass, so typeid can't be compared directly */
+	template <class T>
+	static bool isType(TargetEntity* target) {
+		if (dynamic_cast<T*>(target) == nullptr) return false;
+		// Flying and jumping targets are the only subclasses of TargetEntity
+		return !std::is_same<T, TargetEntity>::value || (dynamic_cast<FlyingEntity*>(target) == nullptr && dynamic_cast<JumpingEntity*>(target) == nullptr);
+	}
+
+public:
+	/** Take a released target of this type, config id, and scale from the pool (returns nullptr if there are none) */
+	template <class T>
+	shared_ptr<T> acquire(const String& id, int scaleIdx) {
+		Array<shared_ptr<TargetEntity>>* free = m_free.getPointer(id);
+		if (notNull(free)) {
+			for (int i = 0; i < free->size(); i++) {
+				const shared_ptr<TargetEntity>& target = (*free)[i];
+				if (target->scaleIndex() == scaleIdx && isType<T>(target.get())) {
+					const shared_ptr<T> t = std::static_pointer_cast<T>(target);
+					free->fastRemove(i);
+					m_freeCount--;
+					m_hits++;
+					return t;
+				}
+			}
+		}
+		m_misses++;
+		return nullptr;
+	}
+
+	/** Return a target (already removed from the scene) to the pool, targets without a config id (i.e. reference targets) aren't pooled */
+	void release(const shared_ptr<TargetEntity>& target) {
+		if (target->id().empty()) return;
+		m_free.getCreate(target->id()).append(target);
+		m_freeCount++;
+	}
+
+	void clear() {
+		m_free.clear();
+		m_freeCount = 0;
+	}
+
+	int size() const { return m_freeCount; }
+	int hits() const { return m_hits; }
+	int misses() const { return m_misses; }
+};
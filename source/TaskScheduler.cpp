@@ -0,0 +1,104 @@
+#include "TaskScheduler.h"
+
+void TaskScheduler::clear(bool weightByCount) {
+	m_weightByCount = weightByCount;
+	m_orderTask.fastClear();
+	m_orderCount.fastClear();
+	m_remaining.fastClear();
+	m_completed.fastClear();
+	m_weights.fastClear();
+	m_tree.fastClear();
+	m_tree.append(0);
+	m_weightTotal = 0;
+	m_taskStart.fastClear();
+	m_taskCompleted.fastClear();
+	m_taskPending.fastClear();
+	m_remainingTotal = 0;
+	m_completedTotal = 0;
+	m_completeTasks = 0;
+	m_unfinishedOrders = 0;
+	m_perBlock = 0.0f;
+}
+
+int TaskScheduler::addTask(int orderCount, int count) {
+	const int task = m_taskStart.size();
+	m_taskStart.append(m_remaining.size());
+	m_taskCompleted.append(0);
+	m_taskPending.append(0);
+	m_completeTasks++;						// Tasks have no remaining runs until the block starts
+	for (int i = 0; i < orderCount; i++) {
+		m_orderTask.append(task);
+		m_orderCount.append(count);
+		m_remaining.append(0);
+		m_completed.append(0);
+		m_weights.append(0);
+		m_tree.append(0);					// Only valid as all weights are zero until the block starts
+	}
+	if (count < 0) m_perBlock = finf();
+	else m_perBlock += float(count * orderCount);
+	return task;
+}
+
+void TaskScheduler::startBlock() {
+	for (int i = 0; i < m_remaining.size(); i++) {
+		m_completed[i] = 0;
+		setRemaining(i, m_orderCount[i] < 0 ? -1 : max(m_remaining[i], 0) + m_orderCount[i]);
+	}
+	for (int t = 0; t < m_taskCompleted.size(); t++) { m_taskCompleted[t] = 0; }
+	m_completedTotal = 0;
+}
+
+void TaskScheduler::setRemaining(int idx, int remaining) {
+	const int old = m_remaining[idx];
+	m_remaining[idx] = remaining;
+	m_remainingTotal += max(remaining, 0) - max(old, 0);
+	m_unfinishedOrders += int(remaining != 0) - int(old != 0);
+
+	// Update the task's pending order count (and whether it is complete)
+	const int task = m_orderTask[idx];
+	const int pending = m_taskPending[task];
+	m_taskPending[task] += int(remaining > 0) - int(old > 0);
+	if (pending == 0 && m_taskPending[task] > 0) m_completeTasks--;
+	else if (pending > 0 && m_taskPending[task] == 0) m_completeTasks++;
+
+	updateWeight(idx);
+}
+
+void TaskScheduler::updateWeight(int idx) {
+	const int remaining = m_remaining[idx];
+	const int weight = remaining == 0 ? 0 : (remaining < 0 || !m_weightByCount) ? 1 : remaining;
+	const int delta = weight - m_weights[idx];
+	if (delta == 0) return;
+	m_weights[idx] = weight;
+	m_weightTotal += delta;
+	for (int i = idx + 1; i < m_tree.size(); i += i & -i) { m_tree[i] += delta; }
+}
+
+bool TaskScheduler::next(bool randomize, int& task, int& order) const {
+	if (m_weightTotal <= 0) return false;		// No remaining tasks
+
+	// Find the first order whose cumulative weight exceeds the target (in order, target the first order with any weight)
+	int target = randomize ? Random::common().integer(0, m_weightTotal - 1) : 0;
+	const int n = m_tree.size() - 1;
+	int step = 1;
+	while (2 * step <= n) { step *= 2; }
+	int pos = 0;
+	for (; step > 0; step /= 2) {
+		if (pos + step <= n && m_tree[pos + step] <= target) {
+			pos += step;
+			target -= m_tree[pos];
+		}
+	}
+
+	task = m_orderTask[pos];
+	order = pos - m_taskStart[task];
+	return true;
+}
+
+void TaskScheduler::complete(int task, int order) {
+	const int idx = m_taskStart[task] + order;
+	m_completed[idx]++;
+	m_taskCompleted[task]++;
+	m_completedTotal++;
+	if (m_remaining[idx] > 0) setRemaining(idx, m_remaining[idx] - 1);
+}
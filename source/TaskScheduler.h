@@ -0,0 +1,68 @@
+#pragma once
+
+#include <G3D/G3D.h>
+
+/** Tracks the remaining/completed count of each (task, trial order) pair in a session and picks the next one to run.
+	Counters are kept incrementally so progress and completion queries are O(1), and (weighted) random selection uses a
+	Fenwick tree over the per-order weights so picking a task is O(log n) regardless of the remaining counts. */
+class TaskScheduler {
+protected:
+	bool			m_weightByCount = true;							///< Weight random selection by remaining count (otherwise each unrun order is equally likely)
+
+	// Per trial order (flattened across tasks)
+	Array<int>		m_orderTask;									///< Task index for each order
+	Array<int>		m_orderCount;									///< Count to add to each order per block (-1 for infinite)
+	Array<int>		m_remaining;									///< Remaining count of each order (-1 for infinite)
+	Array<int>		m_completed;									///< Completed count of each order (this block)
+	Array<int>		m_weights;										///< Current selection weight of each order
+	Array<int>		m_tree;											///< Fenwick tree over m_weights (1-indexed)
+	int				m_weightTotal = 0;								///< Sum of m_weights
+
+	// Per task
+	Array<int>		m_taskStart;									///< Index of the first order for each task
+	Array<int>		m_taskCompleted;								///< Completed count of all orders in each task (this block)
+	Array<int>		m_taskPending;									///< Count of orders with (finite) remaining runs in each task
+
+	// Totals
+	int				m_remainingTotal = 0;							///< Sum of (finite) remaining counts
+	int				m_completedTotal = 0;							///< Sum of completed counts (this block)
+	int				m_completeTasks = 0;							///< Count of tasks without (finite) remaining runs
+	int				m_unfinishedOrders = 0;							///< Count of orders with remaining runs (including infinite ones)
+	float			m_perBlock = 0.0f;								///< Total count of trial orders per block (inf if any are infinite)
+
+	void updateWeight(int idx);
+	void setRemaining(int idx, int remaining);
+
+public:
+	TaskScheduler() { clear(true); }
+
+	/** Remove all tasks, weightByCount selects weighting random selection by remaining count */
+	void clear(bool weightByCount);
+	/** Add a task with orderCount trial orders, each run count times per block (-1 for infinite), returns the task index */
+	int addTask(int orderCount, int count);
+	/** Start a new block, adding each order's count to its remaining count and resetting the completed counts */
+	void startBlock();
+
+	/** Pick the next (task, order) with remaining runs (randomly or in order), returns false if there are none */
+	bool next(bool randomize, int& task, int& order) const;
+	/** Mark a run of the given task and order as complete */
+	void complete(int task, int order);
+
+	int taskCount() const { return m_taskStart.size(); }
+	int completed(int task, int order) const { return m_completed[m_taskStart[task] + order]; }
+	int remaining(int task, int order) const { return m_remaining[m_taskStart[task] + order]; }
+	/** Count of completed runs (of any order) of this task in the current block */
+	int taskCompleted(int task) const { return m_taskCompleted[task]; }
+	/** Count of completed runs (of all tasks) in the current block */
+	int completedTotal() const { return m_completedTotal; }
+	/** Count of tasks without any (finite) remaining runs */
+	int completeTasks() const { return m_completeTasks; }
+	/** Sum of the (finite) remaining counts */
+	int remainingTotal() const { return m_remainingTotal; }
+	/** Are any orders run infinitely? */
+	bool infinite() const { return m_perBlock == finf(); }
+	/** Total count of trial orders per block (inf if any are infinite) */
+	float trialOrdersPerBlock() const { return m_perBlock; }
+	/** Have all orders been run (this block)? */
+	bool blockComplete() const { return m_unfinishedOrders == 0; }
+};
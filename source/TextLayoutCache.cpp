@@ -0,0 +1,48 @@
+#include "TextLayoutCache.h"
+
+void TextLayoutCache::draw(RenderDevice* rd, const String& slot, const shared_ptr<GFont>& font, const String& text, const Point2& pos, float size,
+	const Color4& color, const Color4& border, GFont::XAlign xalign, GFont::YAlign yalign, float lineHeight)
+{
+	bool created = false;
+	Layout& layout = m_layouts.getCreate(slot, created);
+
+	const bool changed = created || layout.font != font || layout.text != text || layout.position != pos || layout.size != size ||
+		layout.color != color || layout.border != border || layout.xalign != xalign || layout.yalign != yalign || layout.lineHeight != lineHeight;
+
+	if (changed) {
+		layout.font = font;
+		layout.text = text;
+		layout.position = pos;
+		layout.size = size;
+		layout.color = color;
+		layout.border = border;
+		layout.xalign = xalign;
+		layout.yalign = yalign;
+		layout.lineHeight = lineHeight;
+
+		buildLayout(rd, layout);
+		m_rebuilds++;
+	}
+	renderLayout(rd, layout);
+}
+
+void TextLayoutCache::buildLayout(RenderDevice* rd, Layout& layout) {
+	layout.vertices.fastClear();
+	layout.indices.fastClear();
+	if (layout.lineHeight > 0.0f) {
+		const Array<String> lines = stringSplit(layout.text, '\n');
+		for (int i = 0; i < lines.size(); i++) {
+			layout.font->appendToCharVertexArray(layout.vertices, layout.indices, rd, lines[i], layout.position + Vector2(0.0f, i * layout.lineHeight),
+				layout.size, layout.color, layout.border, layout.xalign, layout.yalign);
+		}
+	}
+	else {
+		layout.font->appendToCharVertexArray(layout.vertices, layout.indices, rd, layout.text, layout.position, layout.size, layout.color, layout.border, layout.xalign, layout.yalign);
+	}
+}
+
+void TextLayoutCache::renderLayout(RenderDevice* rd, const Layout& layout) {
+	if (layout.vertices.size() > 0) {
+		layout.font->renderCharVertexArray(rd, layout.vertices, layout.indices);
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <G3D/G3D.h>
+
+/** Caches the glyph geometry for text drawn every frame (HUD, FPS indicator, feedback messages).
+	Each named slot keeps the layout of the last text drawn in it, which is only rebuilt when the
+	content, font, size, position, colors, or alignment change. */
+class TextLayoutCache {
+protected:
+	struct Layout {
+		shared_ptr<GFont>				font;								///< Font used to build the layout
+		String							text;								///< Text (may be multiple lines when lineHeight > 0)
+		Point2							position;							///< Position of the (first line of) text
+		float							size = 0.0f;						///< Font size
+		Color4							color;								///< Text color
+		Color4							border;								///< Text outline color
+		GFont::XAlign					xalign = GFont::XALIGN_LEFT;		///< Horizontal alignment
+		GFont::YAlign					yalign = GFont::YALIGN_TOP;			///< Vertical alignment
+		float							lineHeight = 0.0f;					///< Spacing between lines (0 to draw as a single line)
+
+		Array<GFont::CPUCharVertex>		vertices;							///< Cached glyph geometry
+		Array<int>						indices;							///< Cached glyph indices
+	};
+
+	Table<String, Layout>				m_layouts;							///< Layouts (by slot name)
+	int									m_rebuilds = 0;						///< Count of layouts rebuilt (for diagnostics)
+
+	/** Build the glyph geometry for a layout (called only when its inputs change) */
+	virtual void buildLayout(RenderDevice* rd, Layout& layout);
+	/** Draw the cached glyph geometry for a layout */
+	virtual void renderLayout(RenderDevice* rd, const Layout& layout);
+
+public:
+	virtual ~TextLayoutCache() {}
+
+	/** Draw text using the layout cached in the given slot (rebuilding it if any of the inputs have changed).
+		When lineHeight > 0 the text is split on '\n' and each line is placed lineHeight below the previous one. */
+	void draw(RenderDevice* rd, const String& slot, const shared_ptr<GFont>& font, const String& text, const Point2& pos, float size,
+		const Color4& color, const Color4& border = Color4::clear(), GFont::XAlign xalign = GFont::XALIGN_LEFT, GFont::YAlign yalign = GFont::YALIGN_TOP,
+		float lineHeight = 0.0f);
+
+	/** Remove all cached layouts */
+	void clear() { m_layouts.clear(); }
+
+	int rebuildCount() const { return m_rebuilds; }
+};
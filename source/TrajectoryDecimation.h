@@ -0,0 +1,68 @@
+#pragma once
+
+#include <G3D/G3D.h>
+
+/** Last logged trajectory sample of a target (kept per target log index) */
+struct TrajectoryLogState {
+	bool	logged = false;						///< Has this target been logged yet?
+	int		state = -1;							///< Presentation state of the last logged sample
+	double	time = 0.0;							///< Time of the last logged sample (in s)
+	Point3	position;							///< Position of the last logged sample
+	Vector3	velocity;							///< Velocity between the last two logged samples (for dead reckoning)
+	bool	hasVelocity = false;				///< Has a velocity been estimated (i.e. have 2 samples been logged)?
+
+	/** Record a newly logged sample */
+	void update(double t, const Point3& pos, int presentationState) {
+		if (logged && t > time) {
+			velocity = (pos - position) / float(t - time);
+			hasVelocity = true;
+		}
+		time = t;
+		position = pos;
+		state = presentationState;
+		logged = true;
+	}
+};
+
+/** Controls which frames a target's position is logged for (configured per target type) */
+class TrajectoryDecimation {
+public:
+	enum class Mode { Every, Rate, Delta, DeadReckoning };
+	static const Array<String>& modeNames() {
+		static const Array<String> names = { "every", "rate", "delta", "deadReckoning" };
+		return names;
+	}
+
+	Mode	mode = Mode::Every;					///< Decimation mode
+	float	rate = 0.0f;						///< Maximum rate of logged samples (in Hz) for Mode::Rate
+	float	minDistance = 0.0f;					///< Minimum change in position (in m) to log for Mode::Delta (0 for unused)
+	float	minAngle = 0.0f;					///< Minimum change in direction from the player (in deg) to log for Mode::Delta (0 for unused)
+	float	tolerance = 0.0f;					///< Maximum linear extrapolation error (in m) before logging for Mode::DeadReckoning
+
+	/** Should the target be logged at time t (in s) at position pos, given its last logged sample and the viewer position? */
+	bool shouldLog(const TrajectoryLogState& last, double t, const Point3& pos, const Point3& viewer) const {
+		if (!last.logged) return true;
+		switch (mode) {
+		case Mode::Rate:
+			return t - last.time >= 1.0 / double(rate);
+		case Mode::Delta:
+			if (minDistance > 0.0f && (pos - last.position).squaredLength() >= square(minDistance)) return true;
+			if (minAngle > 0.0f) {
+				const float cosAngle = clamp((last.position - viewer).direction().dot((pos - viewer).direction()), -1.0f, 1.0f);
+				if (toDegrees(acosf(cosAngle)) >= minAngle) return true;
+			}
+			// Without any thresholds, log any change in position
+			return minDistance <= 0.0f && minAngle <= 0.0f && pos != last.position;
+		case Mode::DeadReckoning:
+			if (!last.hasVelocity) return true;
+			return (pos - (last.position + last.velocity * float(t - last.time))).squaredLength() > square(tolerance);
+		default:
+			return true;
+		}
+	}
+
+	bool operator==(const TrajectoryDecimation& other) const {
+		return mode == other.mode && rate == other.rate && minDistance == other.minDistance && minAngle == other.minAngle && tolerance == other.tolerance;
+	}
+	bool operator!=(const TrajectoryDecimation& other) const { return !(*this == other); }
+};
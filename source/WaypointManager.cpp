@@ -168,7 +168,7 @@ void WaypointManager::clearWaypoints(void) {
 void WaypointManager::exportWaypoints(String filename, bool saveJSON) {
 	TargetConfig t = TargetConfig();
 	t.id = "test";
-	t.destSpace = "world";
+	t.destSpace = TargetConfig::DestSpace::World;
 	t.destinations = m_waypoints;
 	t.toAny().save(filename, saveJSON);		// Save the file
 }
@@ -194,7 +194,7 @@ shared_ptr<TargetEntity> WaypointManager::spawnDestTargetPreview(
 	// Create the target
 	const String nameStr = name.empty() ? format("destPreview") : name;
 	const int scaleIndex = clamp(iRound(log(size) / log(1.0f + TARGET_MODEL_ARRAY_SCALING) + TARGET_MODEL_ARRAY_OFFSET), 0, TARGET_MODEL_SCALE_COUNT - 1);
-	const shared_ptr<TargetEntity>& target = TargetEntity::create(dests, nameStr, m_app->scene().get(), m_app->targetModels[id][scaleIndex], scaleIndex, 0);
+	const shared_ptr<TargetEntity>& target = TargetEntity::create(dests, nameStr, m_app->scene().get(), m_app->targetModel(id, scaleIndex), scaleIndex, 0);
 
 	// Setup (additional) target parameters
 	target->setFrame(dests[0].position);
@@ -233,7 +233,7 @@ bool WaypointManager::loadWaypoints(String filename) {
 		setWaypoints(t.destinations);
 	}
 
-	if (t.destSpace == "player") {
+	if (t.destSpace == TargetConfig::DestSpace::Player) {
 		CFrame f = m_app->playerCamera->frame();
 		Point3 offset = f.pointToWorldSpace(Point3(0, 0, -1.0f));		// The -1 here matches the session m_targetDistance value
 		// Adjust player space target destinations for preview
@@ -49,7 +49,7 @@ WeaponConfig::WeaponConfig(const Any& any) {
 		reader.getIfPresent("hitDecalColorMult", hitDecalColorMult);
 
 		reader.getIfPresent("fireSpreadDegrees", fireSpreadDegrees);
-		reader.getIfPresent("fireSpreadShape", fireSpreadShape);
+		reader.getEnumIfPresent("fireSpreadShape", fireSpreadShape, spreadShapeNames());
 
 		reader.getIfPresent("damageRollOffAim", damageRollOffAim);
 		reader.getIfPresent("damageRollOffDistance", damageRollOffDistance);
@@ -104,7 +104,7 @@ Any WeaponConfig::toAny(const bool forceAll) const {
 	if (forceAll || def.hitDecalColorMult != hitDecalColorMult)			a["hitDecalColorMult"] = hitDecalColorMult;
 
 	if (forceAll || def.fireSpreadDegrees != fireSpreadDegrees)			a["fireSpreadDegrees"] = fireSpreadDegrees;
-	if (forceAll || def.fireSpreadShape != fireSpreadShape)				a["fireSpreadShape"] = fireSpreadShape;
+	if (forceAll || def.fireSpreadShape != fireSpreadShape)				a["fireSpreadShape"] = spreadShapeNames()[int(fireSpreadShape)];
 	if (forceAll || def.damageRollOffAim != damageRollOffAim)			a["damageRollOffAim"] = damageRollOffAim;
 	if (forceAll || def.damageRollOffDistance != damageRollOffDistance)	a["damageRollOffDistance"] = damageRollOffDistance;
 	if (forceAll || def.scopeFoV != scopeFoV)							a["scopeFoV"] = scopeFoV;
@@ -358,11 +358,13 @@ shared_ptr<TargetEntity> Weapon::fire(
 
 	// Apply random rotation (for fire spread)
 	Matrix3 rotMat = Matrix3::fromEulerAnglesXYZ(0.f,0.f,0.f);
-	if (m_config->fireSpreadShape == "uniform") {
+	switch (m_config->fireSpreadShape) {
+	case WeaponConfig::SpreadShape::Uniform:
 		rotMat = Matrix3::fromEulerAnglesXYZ(m_rand.uniform(-spread / 2, spread / 2), m_rand.uniform(-spread / 2, spread / 2), 0);
-	}
-	else if (m_config->fireSpreadShape == "gaussian") {
+		break;
+	case WeaponConfig::SpreadShape::Gaussian:
 		rotMat = Matrix3::fromEulerAnglesXYZ(m_rand.gaussian(0, spread / 3), m_rand.gaussian(0, spread / 3), 0);
+		break;
 	}
 	Vector3 dir = Vector3(0.f, 0.f, -1.f) * rotMat;
 	ray.set(ray.origin(), m_camera->frame().rotation * dir);
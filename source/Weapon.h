@@ -69,6 +69,12 @@ public:
 /** Weapon configuration class */
 class WeaponConfig {
 public:
+	enum class SpreadShape { Uniform, Gaussian };
+	static const Array<String>& spreadShapeNames() {
+		static const Array<String> names = { "uniform", "gaussian" };
+		return names;
+	}
+
 	String	id = "default";												///< Id by which to refer to this weapon
 	int		maxAmmo = 10000;											///< Max ammo (clicks) allowed per trial (set large for laser mode)
 	float	firePeriod = 0.5;											///< Minimum fire period (set to 0 for laser mode)
@@ -102,7 +108,7 @@ public:
 	float	hitDecalColorMult = 2.0f;									///< "Encoding" field (aka color multiplier) for hit decal
 
 	float	fireSpreadDegrees = 0;										///< The spread of the fire
-	String  fireSpreadShape = "uniform";								///< The shape of the fire spread distribution
+	SpreadShape fireSpreadShape = SpreadShape::Uniform;					///< The shape of the fire spread distribution
 	float	damageRollOffAim = 0;										///< Damage roll off w/ aim
 	float	damageRollOffDistance = 0;									///< Damage roll of w/ distance
 
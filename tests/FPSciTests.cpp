@@ -1,4 +1,18 @@
 #include "FPSciTests.h"
+#include <DelayRing.h>
+#include <HudBatch.h>
+#include <ShaderPassGraph.h>
+#include <FrameTimeSchedule.h>
+#include <ExperimentConfig.h>
+#include <AnyCache.h>
+#include <EventLogger.h>
+#include <LatencyStats.h>
+#include <PhotonProxy.h>
+#include <TaskScheduler.h>
+#include <MessageTemplate.h>
+#include <TrajectoryDecimation.h>
+#include <TargetPool.h>
+#include <TextLayoutCache.h>
 
 std::unique_ptr<GApp::Settings> g_defaultSettings;
 std::unique_ptr<GApp::Settings> g_settings;
@@ -913,4 +927,745 @@ TEST_F(FPSciTests, TestFreshStart) {
 	// Delete the sessions csv
 	failDelete = remove("test/emptystatus.sessions.csv");
 	EXPECT_FALSE(failDelete) << "User Status sessions csv not generated!";
-}
\ No newline at end of file
+}
+
+// Headless tests of the delay buffer ring bookkeeping (no rendering required)
+TEST(DelayRingTests, AllocatesLazily)
+{
+	int allocated = 0;
+	DelayRing<int> ring([&](int idx) { allocated++; return idx; });
+	ring.setCapacity(4);
+	EXPECT_EQ(ring.size(), 0) << "Slots allocated before any frame was written";
+
+	// Slots are only allocated as frames are written, then reused
+	for (int i = 0; i < 10; i++) {
+		ring.beginFrame(double(i));
+		EXPECT_EQ(ring.size(), min(i + 1, 4));
+	}
+	EXPECT_EQ(allocated, 4) << "Ring allocated more slots than its capacity";
+	EXPECT_EQ(ring.allocations(), 4);
+
+	// The oldest slot holds the frame written (capacity - 1) frames ago
+	EXPECT_EQ(ring.time(0), 6.0);
+	EXPECT_EQ(ring.time(ring.size() - 1), 9.0);
+}
+
+TEST(DelayRingTests, ShrinksAndReleases)
+{
+	std::shared_ptr<int> resource = std::make_shared<int>(0);
+	DelayRing<std::shared_ptr<int>> ring([&](int idx) { return resource; });
+	ring.setCapacity(5);
+	for (int i = 0; i < 5; i++) { ring.beginFrame(double(i)); }
+	EXPECT_EQ(resource.use_count(), 6);
+
+	// Dropping the capacity releases the oldest slots, keeping the newest frames
+	ring.setCapacity(2);
+	EXPECT_EQ(ring.size(), 2);
+	EXPECT_EQ(resource.use_count(), 3) << "Shrinking the ring did not release slots";
+	EXPECT_EQ(ring.time(0), 3.0);
+	EXPECT_EQ(ring.time(1), 4.0);
+
+	// Growing the ring doesn't allocate until frames are written
+	ring.setCapacity(3);
+	EXPECT_EQ(ring.size(), 2);
+	ring.beginFrame(5.0);
+	EXPECT_EQ(ring.size(), 3);
+	EXPECT_EQ(ring.time(0), 3.0) << "Growing the ring dropped a delayed frame";
+
+	// Clearing (e.g. at session end) releases everything
+	ring.clear();
+	EXPECT_EQ(ring.size(), 0);
+	EXPECT_EQ(resource.use_count(), 1) << "Clearing the ring did not release slots";
+}
+
+TEST(DelayRingTests, NewestBefore)
+{
+	DelayRing<int> ring([](int idx) { return idx; });
+	ring.setCapacity(8);
+	for (int i = 0; i < 8; i++) { ring.beginFrame(0.01 * i); }
+	EXPECT_EQ(ring.newestBefore(0.035), 3);
+	EXPECT_EQ(ring.newestBefore(0.07), 7);
+	EXPECT_EQ(ring.newestBefore(-1.0), 0) << "Did not fall back to the oldest frame";
+}
+
+// Headless tests of the HUD geometry batch (checks the generated vertex stream)
+TEST(HudBatchTests, RectsAndPolys)
+{
+	HudBatch batch;
+	batch.addRect(Rect2D::xywh(10, 20, 30, 40), Color4(1, 0, 0, 1));
+	ASSERT_EQ(batch.vertexCount(), 6) << "Rectangle should produce 2 triangles";
+	for (const Vector2& v : batch.positions()) {
+		EXPECT_TRUE(v.x == 10 || v.x == 40);
+		EXPECT_TRUE(v.y == 20 || v.y == 60);
+	}
+
+	// A pentagon produces a 3 triangle fan
+	batch.addPoly({ Vector2(0, 0), Vector2(1, 0), Vector2(2, 1), Vector2(1, 2), Vector2(0, 1) }, Color4(0, 1, 0, 1));
+	ASSERT_EQ(batch.vertexCount(), 15);
+	ASSERT_EQ(batch.colors().size(), batch.vertexCount());
+	EXPECT_EQ(batch.colors()[5], Color4(1, 0, 0, 1));
+	EXPECT_EQ(batch.colors()[6], Color4(0, 1, 0, 1));
+
+	batch.clear();
+	EXPECT_EQ(batch.vertexCount(), 0);
+}
+
+TEST(HudBatchTests, RingSegments)
+{
+	HudBatch batch;
+	const Vector2 center(100, 100);
+	batch.addRing(center, 10.0f, 20.0f, 8, 3, Color4::one());
+	ASSERT_EQ(batch.vertexCount(), 3 * 6) << "Each lit ring segment should produce 2 triangles";
+
+	// The first segment starts at the top of the ring (y is down)
+	EXPECT_NEAR(batch.positions()[0].x, 100.0f, 1e-4f);
+	EXPECT_NEAR(batch.positions()[0].y, 80.0f, 1e-4f);
+	for (const Vector2& v : batch.positions()) {
+		const float r = (v - center).length();
+		EXPECT_TRUE(fuzzyEq(r, 10.0f) || fuzzyEq(r, 20.0f)) << "Ring vertex off the inner/outer radius";
+	}
+
+	// Lighting more segments than the subdivision count draws the full ring
+	batch.clear();
+	batch.addRing(center, 10.0f, 20.0f, 8, 20, Color4::one());
+	EXPECT_EQ(batch.vertexCount(), 8 * 6);
+
+	// Ring directions are cached per subdivision count
+	const Array<Vector2>* dirs = &batch.ringDirections(8);
+	EXPECT_EQ(dirs->size(), 9);
+	batch.ringDirections(16);
+	EXPECT_EQ(&batch.ringDirections(8), dirs) << "Ring geometry was rebuilt";
+}
+
+/** Text layout cache that counts layouts instead of building/drawing glyphs (so it can be tested without a GPU) */
+class HeadlessTextLayoutCache : public TextLayoutCache {
+protected:
+	void buildLayout(RenderDevice* rd, Layout& layout) override {}
+	void renderLayout(RenderDevice* rd, const Layout& layout) override {}
+};
+
+// Headless test of text layout change detection
+TEST(TextLayoutCacheTests, RebuildsOnlyOnChange)
+{
+	// Fonts are only compared by identity here (never dereferenced), so stand-ins are used instead of loading font textures
+	const shared_ptr<int> fontOwner = std::make_shared<int>(0);
+	const shared_ptr<GFont> font(fontOwner, reinterpret_cast<GFont*>(fontOwner.get()));
+	const shared_ptr<GFont> otherFont(fontOwner, reinterpret_cast<GFont*>(fontOwner.get() + 1));
+
+	HeadlessTextLayoutCache cache;
+	cache.draw(nullptr, "fps", font, "60 fps", Point2(10, 10), 20.0f, Color3::yellow());
+	EXPECT_EQ(cache.rebuildCount(), 1);
+	cache.draw(nullptr, "fps", font, "60 fps", Point2(10, 10), 20.0f, Color3::yellow());
+	EXPECT_EQ(cache.rebuildCount(), 1) << "Unchanged text was rebuilt";
+
+	cache.draw(nullptr, "fps", font, "59 fps", Point2(10, 10), 20.0f, Color3::yellow());
+	EXPECT_EQ(cache.rebuildCount(), 2) << "Changed content was not rebuilt";
+	cache.draw(nullptr, "fps", otherFont, "59 fps", Point2(10, 10), 20.0f, Color3::yellow());
+	EXPECT_EQ(cache.rebuildCount(), 3) << "Changed font was not rebuilt";
+	cache.draw(nullptr, "fps", otherFont, "59 fps", Point2(10, 10), 24.0f, Color3::yellow());
+	EXPECT_EQ(cache.rebuildCount(), 4) << "Changed size was not rebuilt";
+
+	// Slots are cached independently
+	cache.draw(nullptr, "pacing", font, "59 fps", Point2(10, 10), 20.0f, Color3::yellow());
+	cache.draw(nullptr, "fps", otherFont, "59 fps", Point2(10, 10), 24.0f, Color3::yellow());
+	EXPECT_EQ(cache.rebuildCount(), 5);
+}
+
+// Headless test of the frame time window min/max against a full rescan
+TEST(FrameTimeWindowTests, MatchesRescan)
+{
+	const int length = 16;
+	FrameTimeWindow window(length);
+	Array<float> samples;
+	Random rng(1234, false);
+	for (int i = 0; i < 200; i++) {
+		const float t = rng.uniform(0.001f, 0.02f);
+		samples.append(t);
+		window.add(t);
+
+		float expectedMin = finf(), expectedMax = -finf();
+		for (int j = max(0, samples.size() - length); j < samples.size(); j++) {
+			expectedMin = min(expectedMin, samples[j]);
+			expectedMax = max(expectedMax, samples[j]);
+		}
+		ASSERT_EQ(window.size(), min(samples.size(), length));
+		ASSERT_EQ(window.minimum(), expectedMin) << "Incorrect minimum after " << i + 1 << " samples";
+		ASSERT_EQ(window.maximum(), expectedMax) << "Incorrect maximum after " << i + 1 << " samples";
+	}
+}
+
+// Headless tests of the shader pass graph builder (pass skipping and target aliasing)
+static ShaderPassConfig makeShaderPass(const String& name, const String& shader, int width = 0, int height = 0, const String& input = "") {
+	ShaderPassConfig pass;
+	pass.name = name;
+	pass.shader = shader;
+	pass.input = input;
+	pass.resolution = { width, height };
+	return pass;
+}
+
+TEST(ShaderPassGraphTests, SkipsPassThrough)
+{
+	ShaderPassGraph graph;
+	graph.build({ makeShaderPass("copy", "") }, 1920, 1080);
+	EXPECT_EQ(graph.passes().size(), 0) << "Pass-through pass was not skipped";
+	EXPECT_EQ(graph.skippedCount(), 1);
+	EXPECT_EQ(graph.targets().size(), 0);
+	EXPECT_EQ(graph.output(), ShaderPassGraph::STAGE_INPUT);
+
+	// A resize (without a shader) still needs to run
+	graph.build({ makeShaderPass("resize", "", 640, 360) }, 1920, 1080);
+	ASSERT_EQ(graph.passes().size(), 1);
+	ASSERT_EQ(graph.targets().size(), 1);
+	EXPECT_EQ(graph.targets()[0].width, 640);
+	EXPECT_EQ(graph.passes()[0].input, ShaderPassGraph::STAGE_INPUT);
+}
+
+TEST(ShaderPassGraphTests, AliasesTargets)
+{
+	ShaderPassGraph graph;
+	// A chain of same-sized passes only needs 2 (ping-pong) targets
+	graph.build({ makeShaderPass("a", "a.pix"), makeShaderPass("b", "b.pix"), makeShaderPass("c", "c.pix"), makeShaderPass("d", "d.pix") }, 100, 100);
+	ASSERT_EQ(graph.passes().size(), 4);
+	EXPECT_EQ(graph.targets().size(), 2) << "Chained passes did not share targets";
+	for (const ShaderPassGraph::Pass& pass : graph.passes()) {
+		EXPECT_NE(pass.input, pass.output) << "Pass reads and writes the same target";
+	}
+	EXPECT_EQ(graph.output(), graph.passes().last().output);
+
+	// A named input keeps its target alive until it is read
+	graph.build({ makeShaderPass("a", "a.pix"), makeShaderPass("b", "b.pix"), makeShaderPass("c", "c.pix", 0, 0, "a") }, 100, 100);
+	ASSERT_EQ(graph.passes().size(), 3);
+	EXPECT_EQ(graph.passes()[2].input, graph.passes()[0].output);
+	EXPECT_NE(graph.passes()[1].output, graph.passes()[0].output) << "Target reused while still in use";
+	EXPECT_EQ(graph.passes()[2].output, graph.passes()[1].output) << "Unused target was not reused";
+	EXPECT_EQ(graph.targets().size(), 2);
+
+	// Targets of different sizes are never shared
+	graph.build({ makeShaderPass("a", "a.pix", 50, 50), makeShaderPass("b", "b.pix", 100, 100), makeShaderPass("c", "c.pix", 50, 50) }, 100, 100);
+	EXPECT_EQ(graph.targets().size(), 3);
+}
+
+TEST(ShaderPassGraphTests, WritesOutputDirectly)
+{
+	ShaderPassGraph graph;
+	// A single pass can't write its own input
+	graph.build({ makeShaderPass("a", "a.pix") }, 100, 100, 100, 100, true);
+	ASSERT_EQ(graph.passes().size(), 1);
+	EXPECT_EQ(graph.targets().size(), 1);
+	EXPECT_NE(graph.output(), ShaderPassGraph::STAGE_OUTPUT);
+
+	// The last of several passes writes the stage output (no copy back)
+	graph.build({ makeShaderPass("a", "a.pix"), makeShaderPass("b", "b.pix") }, 100, 100, 100, 100, true);
+	ASSERT_EQ(graph.passes().size(), 2);
+	EXPECT_EQ(graph.targets().size(), 1);
+	EXPECT_EQ(graph.output(), ShaderPassGraph::STAGE_OUTPUT);
+	EXPECT_EQ(graph.passes()[1].output, ShaderPassGraph::STAGE_OUTPUT);
+
+	// Unknown inputs are an error
+	EXPECT_ANY_THROW(graph.build({ makeShaderPass("a", "a.pix", 0, 0, "missing") }, 100, 100));
+}
+
+static RenderConfig makeProfileConfig(const String& profileAny) {
+	RenderConfig config;
+	config.frameTimeProfiles.append(FrameTimeProfileConfig(Any::parse(profileAny)));
+	config.frameTimeProfile = config.frameTimeProfiles[0].name;
+	return config;
+}
+
+TEST(FrameTimeScheduleTests, StepAndRamp)
+{
+	FrameTimeSchedule schedule;
+	// Step from 10ms to 20ms at 0.05s (base frame time of 5ms before the first keypoint)
+	schedule.compile(makeProfileConfig("{ name = \"step\"; type = \"step\"; times = [0.02, 0.05]; frameTimes = [0.01, 0.02]; duration = 0.1; }"), 0.005f);
+	ASSERT_TRUE(schedule.active());
+	const Array<float>& frameTimes = schedule.frameTimes();
+	double time = 0.0;
+	for (float frameTime : frameTimes) {
+		const float expected = time < 0.02f ? 0.005f : (time < 0.05f ? 0.01f : 0.02f);
+		EXPECT_FLOAT_EQ(frameTime, expected) << "Incorrect frame time at " << time << "s";
+		time += frameTime;
+	}
+	EXPECT_GE(time, 0.1) << "Schedule ended early";
+	EXPECT_FLOAT_EQ(schedule.holdFrameTime(), 0.02f);
+	EXPECT_FLOAT_EQ(schedule.minFrameTime(), 0.005f);
+	EXPECT_EQ(schedule.condition(), "step") << "Profile condition is not labeled by the profile name";
+
+	// Ramp from 10ms to 20ms over 1s
+	schedule.compile(makeProfileConfig("{ name = \"ramp\"; type = \"ramp\"; times = [0, 1]; frameTimes = [0.01, 0.02]; }"), 0.005f);
+	ASSERT_GT(schedule.size(), 2);
+	EXPECT_FLOAT_EQ(schedule.frameTimes()[0], 0.01f);
+	for (int i = 1; i < schedule.size(); i++) {
+		EXPECT_GE(schedule.frameTimes()[i], schedule.frameTimes()[i - 1]) << "Ramp is not monotonic";
+	}
+	EXPECT_LE(schedule.frameTimes().last(), 0.02f);
+}
+
+TEST(FrameTimeScheduleTests, StutterAndTrace)
+{
+	FrameTimeSchedule schedule;
+	// A constant 50ms stutter every 0.1s on a 10ms base frame time
+	schedule.compile(makeProfileConfig("{ name = \"stutter\"; type = \"stutter\"; frameTimes = [0.01]; stutterPeriod = 0.1; stutterAmplitude = 0.05; duration = 1; }"), 0.005f);
+	int stutters = 0;
+	for (float frameTime : schedule.frameTimes()) {
+		if (frameTime > 0.01f + 1e-6f) {
+			stutters++;
+			EXPECT_FLOAT_EQ(frameTime, 0.06f);
+		}
+	}
+	EXPECT_GE(stutters, 6);
+	EXPECT_LE(stutters, 10);
+
+	// Without a duration, a window of stutter periods is compiled and looped (instead of the entire maximum trial duration)
+	schedule.compile(makeProfileConfig("{ name = \"stutter\"; type = \"stutter\"; frameTimes = [0.01]; stutterPeriod = 0.1; stutterAmplitude = 0.05; }"), 0.005f);
+	EXPECT_LE(schedule.size(), iCeil(FrameTimeSchedule::STUTTER_LOOP_PERIODS * 0.1f / 0.01f) + 1);
+	const int windowFrames = schedule.size();
+	for (int i = 0; i < windowFrames; i++) { schedule.next(true); }
+	EXPECT_FLOAT_EQ(schedule.next(true), schedule.frameTimes()[0]) << "Stutter window did not loop";
+
+	// Trace replay holds the last frame time (or loops when requested)
+	const Array<float> trace = FrameTimeProfileConfig::parseTrace("Application,MsBetweenPresents\ngame.exe,10\ngame.exe,20\n", "MsBetweenPresents");
+	ASSERT_EQ(trace.size(), 2);
+	EXPECT_FLOAT_EQ(trace[1], 0.02f);
+	EXPECT_EQ(FrameTimeProfileConfig::parseTrace("5\n6\n7\n", "MsBetweenPresents").size(), 3);
+
+	schedule.compile(makeProfileConfig("{ name = \"trace\"; type = \"trace\"; frameTimes = [0.01, 0.02]; }"), 0.005f);
+	EXPECT_FLOAT_EQ(schedule.next(true), 0.01f);
+	EXPECT_FLOAT_EQ(schedule.next(true), 0.02f);
+	EXPECT_FLOAT_EQ(schedule.next(true), 0.02f);
+	schedule.startTask();
+	EXPECT_FLOAT_EQ(schedule.next(true), 0.01f) << "Profile did not restart with the task";
+
+	schedule.compile(makeProfileConfig("{ name = \"trace\"; type = \"trace\"; frameTimes = [0.01, 0.02]; loop = true; }"), 0.005f);
+	schedule.next(true);
+	schedule.next(true);
+	EXPECT_FLOAT_EQ(schedule.next(true), 0.01f) << "Profile did not loop";
+}
+
+TEST(FrameTimeScheduleTests, FrameTimeArrayModes)
+{
+	FrameTimeSchedule schedule;
+	RenderConfig config;
+	config.frameTimeArray = { 0.01f, 0.02f, 0.03f };
+	config.frameTimeMode = RenderConfig::FrameTimeMode::TaskOnly;
+	schedule.compile(config, 0.005f);
+	EXPECT_EQ(schedule.condition(), "33-100 fps");
+	EXPECT_FLOAT_EQ(schedule.next(false), 0.005f) << "Task only mode used the schedule outside of the task";
+	EXPECT_FLOAT_EQ(schedule.next(true), 0.01f);
+	EXPECT_FLOAT_EQ(schedule.next(true), 0.02f);
+
+	// Recompiling (for the next trial) keeps our place in the array unless restarting with the task
+	schedule.compile(config, 0.005f);
+	schedule.startTask();
+	EXPECT_FLOAT_EQ(schedule.next(true), 0.03f);
+	EXPECT_FLOAT_EQ(schedule.next(true), 0.01f) << "Frame time array did not wrap";
+	config.frameTimeMode = RenderConfig::FrameTimeMode::RestartWithTask;
+	schedule.compile(config, 0.005f);
+	schedule.startTask();
+	EXPECT_FLOAT_EQ(schedule.next(true), 0.01f);
+
+	// No array or profile leaves the schedule inactive
+	schedule.compile(RenderConfig(), 0.005f);
+	EXPECT_FALSE(schedule.active());
+	EXPECT_EQ(schedule.condition(), "200 fps");
+}
+
+TEST(ConfigOptionTests, EnumRoundTrip)
+{
+	RenderConfig config;
+	config.load(FPSciAnyTableReader(Any::parse("{ frameTimeMode = \"TASKONLY\"; framePacing = \"Hybrid\"; }")));
+	EXPECT_EQ(config.frameTimeMode, RenderConfig::FrameTimeMode::TaskOnly);
+	EXPECT_EQ(config.framePacing, RenderConfig::FramePacing::Hybrid);
+
+	// Options are written back using their canonical names (and read back to the same values)
+	const Any a = config.addToAny(Any(Any::TABLE));
+	EXPECT_EQ(a["frameTimeMode"].string(), "taskOnly");
+	EXPECT_EQ(a["framePacing"].string(), "hybrid");
+	RenderConfig reloaded;
+	reloaded.load(FPSciAnyTableReader(a));
+	EXPECT_EQ(reloaded.frameTimeMode, config.frameTimeMode);
+	EXPECT_EQ(reloaded.framePacing, config.framePacing);
+
+	// Invalid options are rejected at load
+	EXPECT_ANY_THROW(RenderConfig().load(FPSciAnyTableReader(Any::parse("{ framePacing = \"busy\"; }"))));
+	HudConfig hud;
+	EXPECT_ANY_THROW(hud.load(FPSciAnyTableReader(Any::parse("{ cooldownMode = \"circle\"; }"))));
+}
+
+/** Build a large synthetic experiment (64 sessions of 32 trials, using vector/color fields throughout) */
+static String syntheticExperimentText() {
+	String text = "{ description = \"benchmark\"; targets = [ { id = \"static\"; destSpace = \"player\"; speed = [0, 0]; visualSize = [0.05, 0.05]; } ]; sessions = [";
+	for (int s = 0; s < 64; s++) {
+		text += format("%s{ id = \"s%d\"; frameRate = %d; moveScale = [1, 0.5]; trials = [", s > 0 ? ", " : "", s, 60 + s);
+		for (int t = 0; t < 32; t++) {
+			text += format("%s{ id = \"t%d\"; targetIds = [\"static\"]; count = 2; referenceTargetColor = [%f, 1, 0, 1]; }", t > 0 ? ", " : "", t, t / 32.0f);
+		}
+		text += "]; }";
+	}
+	text += "]; }";
+	return text;
+}
+
+TEST(ConfigLoadTests, StartupBenchmark)
+{
+	const String filename = "startupBenchmark.Experiment.Any";
+	const String cacheFilename = AnyCache::cacheFilename(filename);
+	writeWholeFile(filename, syntheticExperimentText());
+	FileSystem::removeFile(cacheFilename);
+
+	RealTime start = System::time();
+	const Any parsed = Any::fromFile(filename);
+	const RealTime parseTime = System::time() - start;
+
+	start = System::time();
+	const ExperimentConfig config(parsed);
+	const RealTime configTime = System::time() - start;
+
+	AnyCache::load(filename, true);			// Writes the cache
+	start = System::time();
+	const Any cached = AnyCache::load(filename, true);
+	const RealTime cacheTime = System::time() - start;
+
+	// Reported in the test results (i.e. --gtest_output=xml), times in ms
+	RecordProperty("textParseMs", format("%.1f", 1000.0 * parseTime).c_str());
+	RecordProperty("configConstructionMs", format("%.1f", 1000.0 * configTime).c_str());
+	RecordProperty("cachedLoadMs", format("%.1f", 1000.0 * cacheTime).c_str());
+	EXPECT_EQ(config.sessions.size(), 64);
+
+	FileSystem::removeFile(filename);
+	FileSystem::removeFile(cacheFilename);
+}
+
+TEST(ConfigLoadTests, CacheRoundTrip)
+{
+	const String text = syntheticExperimentText();
+	const String filename = "cacheRoundTrip.Experiment.Any";
+	const String cacheFilename = AnyCache::cacheFilename(filename);
+	writeWholeFile(filename, text);
+	FileSystem::removeFile(cacheFilename);
+
+	// The first load writes the cache (in the cache directory, not next to the config)
+	const ExperimentConfig fromText(AnyCache::load(filename, true));
+	EXPECT_TRUE(FileSystem::exists(cacheFilename));
+	EXPECT_FALSE(FileSystem::exists(filename + ".cache"));
+
+	// The cached tree produces the same experiment config as the text
+	const ExperimentConfig fromCache(AnyCache::load(filename, true));
+	EXPECT_EQ(fromText.sessions.size(), 64);
+	EXPECT_EQ(fromText.sessions[63].trials.size(), 32);
+	EXPECT_EQ(fromCache.toAny().unparse(), fromText.toAny().unparse());
+
+	// Editing the file invalidates the cache
+	const uint64 hash = AnyCache::contentHash(filename);
+	const size_t descIdx = text.find("benchmark");
+	writeWholeFile(filename, text.substr(0, descIdx) + "edited" + text.substr(descIdx + strlen("benchmark")));
+	EXPECT_NE(AnyCache::contentHash(filename), hash);
+	EXPECT_EQ(ExperimentConfig(AnyCache::load(filename, true)).description, "edited");
+
+	FileSystem::removeFile(filename);
+	FileSystem::removeFile(cacheFilename);
+}
+
+TEST(EventLoggerTests, ParsesAndMeasures)
+{
+	uint64 timeUs;
+	EventLogger::EventType type;
+	EXPECT_TRUE(EventLogger::parseLine("123456:PD\r", 10, timeUs, type));
+	EXPECT_EQ(timeUs, 123456ull);
+	EXPECT_EQ(type, EventLogger::EventType::PD);
+	EXPECT_FALSE(EventLogger::parseLine("123456:512", 10, timeUs, type));		// ADC sample
+	EXPECT_FALSE(EventLogger::parseLine("Hardware Event Logger", 21, timeUs, type));
+
+	EventLogger logger("none");
+	auto line = [&](const String& text, uint64 hostTicks) { logger.processLine(text.c_str(), int(text.size()), hostTicks); };
+	line("1000000:M1", 0);
+	line("1020000:M1", 0);						// Debounced (within 100ms of the last click)
+	line("1025000:PD", 0);
+	EXPECT_EQ(logger.eventCount(), 2);
+	EXPECT_EQ(logger.latencyCount(), 1);
+	EXPECT_FLOAT_EQ(logger.lastLatencyMs(), 25.0f);
+
+	line("2000000:M1", 0);
+	line("2500000:PD", 0);						// Too late to be this click's photon
+	EXPECT_EQ(logger.latencyCount(), 1);
+
+	// The 32-bit device timer wraps around
+	line("4294950000:M1", 0);
+	line("12704:PD", 0);						// 2^32 + 12704 us is 30ms after the click
+	EXPECT_EQ(logger.latencyCount(), 2);
+	EXPECT_FLOAT_EQ(logger.lastLatencyMs(), 30.0f);
+}
+
+TEST(EventLoggerTests, EmulatorRoundTrip)
+{
+	const shared_ptr<EventLoggerEmulator> emulator = std::make_shared<EventLoggerEmulator>();
+	shared_ptr<EventLogger> logger = EventLogger::create(emulator);
+	ASSERT_TRUE(logger->start(nullptr, "minimum"));
+	emulator->send(5000000, EventLogger::EventType::M1);
+	emulator->sendAdc(5001000, 300);
+	emulator->sendRaw("5012");									// Lines split across reads are reassembled
+	emulator->sendRaw("500:PD\n");
+
+	const RealTime start = System::time();
+	while (logger->latencyCount() < 1 && System::time() - start < 2.0) { System::sleep(0.01); }
+	logger->stop();
+	EXPECT_EQ(emulator->received(), "aoff\n");
+	EXPECT_EQ(logger->eventCount(), 2);
+	EXPECT_FLOAT_EQ(logger->lastLatencyMs(), 12.5f);
+}
+
+TEST(LatencyStatsTests, SketchQuantiles)
+{
+	// Quantiles are within the sketch's relative error of the exact values
+	LatencySketch sketch;
+	for (int i = 1; i <= 1000; i++) { sketch.add(10.0f + 0.04f * i); }		// 10.04 to 50ms
+	EXPECT_EQ(sketch.count(), 1000);
+	EXPECT_NEAR(sketch.quantile(0.5f), 30.0f, 30.0f * LatencySketch::RELATIVE_ERROR);
+	EXPECT_NEAR(sketch.quantile(0.95f), 48.0f, 48.0f * LatencySketch::RELATIVE_ERROR);
+	EXPECT_NEAR(sketch.quantile(0.99f), 49.6f, 49.6f * LatencySketch::RELATIVE_ERROR);
+	EXPECT_NEAR(sketch.quantile(1.0f), 50.0f, 50.0f * LatencySketch::RELATIVE_ERROR);
+	sketch.clear();
+	EXPECT_EQ(sketch.quantile(0.5f), 0.0f);
+
+	// Trials are reset, conditions accumulate across trials
+	ClickToPhotonStats stats;
+	stats.startTrial("60 fps");
+	stats.add(20.0f);
+	stats.startTrial("60 fps");
+	stats.add(30.0f);
+	stats.add(30.0f);
+	EXPECT_EQ(stats.trial().count(), 2);
+	EXPECT_EQ(stats.currentCondition().count(), 3);
+	stats.startTrial("120 fps");
+	EXPECT_EQ(stats.currentCondition().count(), 0);
+
+	// Latencies between trials (i.e. feedback clicks) are ignored, the last trial is kept until the next starts
+	stats.add(10.0f);
+	stats.endTrial();
+	stats.add(10.0f);
+	EXPECT_EQ(stats.trial().count(), 1);
+	EXPECT_EQ(stats.currentCondition().count(), 1);
+}
+
+/** Present clock with a settable present time (for testing) */
+class TestPresentClock : public PhotonProxy::PresentClock {
+public:
+	RealTime presentTime = -1.0;
+	bool lastPresentTime(RealTime& time) override {
+		time = presentTime;
+		return presentTime >= 0.0;
+	}
+};
+
+TEST(PhotonProxyTests, SubmitAndPresent)
+{
+	// Without a present clock the (delayed) submit time is used
+	PhotonProxy proxy;
+	Array<PhotonProxy::Estimate> estimates;
+	proxy.onInput(1.000, 0);
+	proxy.onInput(1.002, 0);			// Only the first input before a shot counts
+	proxy.onShot(1);
+	proxy.onShot(1);					// Shots without a new input (i.e. automatic fire) aren't tracked
+	EXPECT_EQ(proxy.pendingCount(), 1);
+	proxy.onSubmit(1, 1.010, 0.005f);
+	proxy.takeEstimates(estimates);
+	ASSERT_EQ(estimates.size(), 1);
+	EXPECT_NEAR(estimates[0].latencyMs(), 15.0f, 1e-3f);
+	EXPECT_EQ(estimates[0].mode(), "submit");
+
+	// Inputs not consumed by a shot are dropped
+	proxy.onInput(2.000, 0);
+	proxy.clearInput();
+	proxy.onShot(2);
+	EXPECT_EQ(proxy.pendingCount(), 0);
+
+	// With a present clock, wait for a present at/after the submit
+	shared_ptr<TestPresentClock> clock = std::make_shared<TestPresentClock>();
+	proxy.setPresentClock(clock);
+	proxy.onInput(3.000, 0);
+	proxy.onShot(3);
+	clock->presentTime = 2.995;
+	proxy.onSubmit(3, 3.008);
+	proxy.takeEstimates(estimates);
+	EXPECT_EQ(estimates.size(), 0);
+	clock->presentTime = 3.012;
+	proxy.onSubmit(4, 3.020);
+	proxy.takeEstimates(estimates);
+	ASSERT_EQ(estimates.size(), 1);
+	EXPECT_NEAR(estimates[0].latencyMs(), 12.0f, 1e-3f);
+	EXPECT_EQ(estimates[0].mode(), "present");
+
+	// Fall back to the submit time if the present clock stops advancing
+	proxy.onInput(4.000, 0);
+	proxy.onShot(5);
+	proxy.onSubmit(5, 4.010);
+	proxy.onSubmit(6, 4.010 + PhotonProxy::MAX_PRESENT_WAIT_S + 0.01);
+	proxy.takeEstimates(estimates);
+	ASSERT_EQ(estimates.size(), 1);
+	EXPECT_NEAR(estimates[0].latencyMs(), 10.0f, 1e-3f);
+	EXPECT_EQ(estimates[0].mode(), "submit");
+}
+
+TEST(TaskSchedulerTests, CountsAndSelection)
+{
+	TaskScheduler tasks;
+	tasks.clear(true);
+	tasks.addTask(2, 3);			// Task 0 has 2 trial orders run 3 times each
+	tasks.addTask(1, 1);			// Task 1 has a single trial order run once
+	tasks.startBlock();
+	EXPECT_EQ(tasks.trialOrdersPerBlock(), 7.0f);
+	EXPECT_EQ(tasks.remainingTotal(), 7);
+	EXPECT_EQ(tasks.completeTasks(), 0);
+
+	// In order selection picks the first unrun order
+	int task, order;
+	ASSERT_TRUE(tasks.next(false, task, order));
+	EXPECT_EQ(task, 0);
+	EXPECT_EQ(order, 0);
+	tasks.complete(1, 0);
+	EXPECT_EQ(tasks.completeTasks(), 1);
+	EXPECT_EQ(tasks.taskCompleted(1), 1);
+
+	// Random selection never picks a finished order, and the block completes after all runs
+	for (int i = 0; i < 6; i++) {
+		ASSERT_TRUE(tasks.next(true, task, order));
+		EXPECT_EQ(task, 0);
+		EXPECT_GT(tasks.remaining(task, order), 0);
+		tasks.complete(task, order);
+	}
+	EXPECT_TRUE(tasks.blockComplete());
+	EXPECT_FALSE(tasks.next(true, task, order));
+	EXPECT_EQ(tasks.completedTotal(), 7);
+	EXPECT_EQ(tasks.completeTasks(), 2);
+
+	// Starting a new block resets the completed counts
+	tasks.startBlock();
+	EXPECT_EQ(tasks.remainingTotal(), 7);
+	EXPECT_EQ(tasks.completedTotal(), 0);
+	EXPECT_FALSE(tasks.blockComplete());
+
+	// Infinite tasks are always selectable and never complete the block
+	TaskScheduler infinite;
+	infinite.clear(false);
+	infinite.addTask(1, -1);
+	infinite.startBlock();
+	EXPECT_TRUE(infinite.infinite());
+	for (int i = 0; i < 10; i++) {
+		ASSERT_TRUE(infinite.next(true, task, order));
+		infinite.complete(task, order);
+	}
+	EXPECT_FALSE(infinite.blockComplete());
+}
+
+TEST(TargetPoolTests, AcquireAndRelease)
+{
+	// Targets are created (as in the session) without a scene or model, they are never added to a scene here
+	shared_ptr<TargetConfig> config = std::make_shared<TargetConfig>();
+	config->id = "target";
+	config->destinations.append(Destination());
+	const shared_ptr<FlyingEntity> flying = FlyingEntity::create(config, "flying", nullptr, nullptr, Point3::zero(), 1, 0);
+	const shared_ptr<TargetEntity> dest = TargetEntity::create(config, "dest", nullptr, nullptr, Point3::zero(), 1, 0);
+	const shared_ptr<FlyingEntity> reference = FlyingEntity::create("reference", nullptr, nullptr, CFrame());		// Reference targets have no config id
+
+	TargetPool pool;
+	pool.release(flying);
+	pool.release(dest);
+	pool.release(reference);
+	EXPECT_EQ(pool.size(), 2) << "Target without a config id was pooled";
+
+	// Targets are only reused for the same scale index and type
+	EXPECT_EQ(pool.acquire<FlyingEntity>("target", 0), nullptr);
+	EXPECT_EQ(pool.acquire<JumpingEntity>("target", 1), nullptr);
+	EXPECT_EQ(pool.acquire<FlyingEntity>("other", 1), nullptr);
+	EXPECT_EQ(pool.acquire<TargetEntity>("target", 1), dest) << "Acquired a flying target as a (destination) target";
+	EXPECT_EQ(pool.acquire<FlyingEntity>("target", 1), flying);
+	EXPECT_EQ(pool.acquire<FlyingEntity>("target", 1), nullptr) << "Target was acquired twice";
+	EXPECT_EQ(pool.size(), 0);
+	EXPECT_EQ(pool.hits(), 2);
+	EXPECT_EQ(pool.misses(), 4);
+
+	pool.release(flying);
+	pool.clear();
+	EXPECT_EQ(pool.size(), 0);
+	EXPECT_EQ(pool.acquire<FlyingEntity>("target", 1), nullptr);
+}
+
+TEST(MessageTemplateTests, CompileAndRender)
+{
+	// Variables are replaced, other '%' characters are kept
+	MessageTemplate msg("Block %lastBlock complete (50%)! Starting block %currBlock.", MessageTemplate::feedbackVars(), "blockCompleteFeedback");
+	EXPECT_TRUE(msg.uses(MessageTemplate::Var::LastBlock));
+	EXPECT_FALSE(msg.uses(MessageTemplate::Var::SessionScore));
+	String out;
+	msg.render(out, [](MessageTemplate::Var var, String& o) { o.append(var == MessageTemplate::Var::LastBlock ? "1" : "2"); });
+	EXPECT_EQ(out, "Block 1 complete (50%)! Starting block 2.");
+
+	// Unknown variables (and variables from the wrong set) are reported when compiling
+	EXPECT_ANY_THROW(MessageTemplate("%trialShots", MessageTemplate::feedbackVars(), "trialSuccessFeedback"));
+	EXPECT_ANY_THROW(MessageTemplate("%dbFilename", MessageTemplate::feedbackVars(), "trialSuccessFeedback"));
+
+	// Commands keep environment variables
+	MessageTemplate cmd("cmd /c echo %DATE%>> %dbFilename.txt", MessageTemplate::commandVars(), "command", true);
+	cmd.render(out, [](MessageTemplate::Var var, String& o) { o.append("results"); });
+	EXPECT_EQ(out, "cmd /c echo %DATE%>> results.txt");
+
+	// Default feedback messages are precompiled, loaded messages are recompiled (and checked) when changed
+	FeedbackConfig feedback;
+	EXPECT_TRUE(feedback.trialSuccessMsg.uses(MessageTemplate::Var::TrialTaskTimeMs));
+	feedback.load(FPSciAnyTableReader(Any::parse("{ trialSuccessFeedback = \"%trialShotsHit hits!\"; }")));
+	EXPECT_TRUE(feedback.trialSuccessMsg.uses(MessageTemplate::Var::TrialShotsHit));
+	EXPECT_TRUE(FeedbackConfig().trialSuccessMsg.uses(MessageTemplate::Var::TrialTaskTimeMs)) << "Loading changed the default messages";
+	EXPECT_ANY_THROW(feedback.load(FPSciAnyTableReader(Any::parse("{ trialFailureFeedback = \"%trialShots\"; }"))));
+}
+
+TEST(TrajectoryDecimationTests, ShouldLog)
+{
+	TrajectoryDecimation dec;
+	TrajectoryLogState last;
+	const Point3 viewer = Point3::zero();
+
+	// The first sample is always logged
+	dec.mode = TrajectoryDecimation::Mode::Rate;
+	dec.rate = 10.0f;
+	EXPECT_TRUE(dec.shouldLog(last, 0.0, Point3(0, 0, -10), viewer));
+	last.update(0.0, Point3(0, 0, -10), 0);
+	EXPECT_FALSE(dec.shouldLog(last, 0.05, Point3(1, 0, -10), viewer));
+	EXPECT_TRUE(dec.shouldLog(last, 0.1, Point3(1, 0, -10), viewer));
+
+	// Positional/angular deltas (either threshold logs)
+	dec.mode = TrajectoryDecimation::Mode::Delta;
+	dec.rate = 0.0f;
+	dec.minDistance = 0.5f;
+	EXPECT_FALSE(dec.shouldLog(last, 0.01, Point3(0.4f, 0, -10), viewer));
+	EXPECT_TRUE(dec.shouldLog(last, 0.01, Point3(0.6f, 0, -10), viewer));
+	dec.minDistance = 0.0f;
+	dec.minAngle = 1.0f;
+	EXPECT_FALSE(dec.shouldLog(last, 0.01, Point3(0.1f, 0, -10), viewer));		// ~0.57 deg
+	EXPECT_TRUE(dec.shouldLog(last, 0.01, Point3(0.2f, 0, -10), viewer));		// ~1.15 deg
+
+	// Dead reckoning logs once linear extrapolation of the last 2 logged samples is off by more than the tolerance
+	dec.mode = TrajectoryDecimation::Mode::DeadReckoning;
+	dec.tolerance = 0.1f;
+	EXPECT_TRUE(dec.shouldLog(last, 0.5, Point3(0, 0, -10), viewer));			// Only 1 sample logged
+	last.update(1.0, Point3(1, 0, -10), 0);										// Moving at 1 m/s in x
+	EXPECT_FALSE(dec.shouldLog(last, 2.0, Point3(2.05f, 0, -10), viewer));
+	EXPECT_TRUE(dec.shouldLog(last, 2.0, Point3(2.0f, 0.2f, -10), viewer));
+}
+
+TEST(PlayerActionTests, NoChangeTolerance)
+{
+	FILETIME t = {};
+	PlayerAction last(t, Point2(10.0f, 5.0f), Point3(1, 0, 0), PresentationState::trialTask, PlayerActionType::Aim);
+	PlayerAction noise(t, Point2(10.001f, 5.0f), Point3(1.0005f, 0, 0), PresentationState::trialTask, PlayerActionType::Aim);
+	EXPECT_FALSE(noise.noChangeFrom(last));								// Exact comparison by default
+	EXPECT_TRUE(noise.noChangeFrom(last, 0.01f, 0.001f));
+	EXPECT_FALSE(noise.noChangeFrom(last, 0.0001f, 0.001f));
+	EXPECT_FALSE(noise.noChangeFrom(last, 0.01f, 0.0001f));
+
+	// Actions on different targets are compared by registry id
+	PlayerAction hitA(t, Point2(10.0f, 5.0f), Point3(1, 0, 0), PresentationState::trialTask, PlayerActionType::Hit, 1);
+	PlayerAction hitB(t, Point2(10.0f, 5.0f), Point3(1, 0, 0), PresentationState::trialTask, PlayerActionType::Hit, 2);
+	EXPECT_TRUE(hitA.noChangeFrom(hitA));
+	EXPECT_FALSE(hitB.noChangeFrom(hitA));
+	EXPECT_FALSE(hitA.noChangeFrom(last));
+}